@@ -2,27 +2,88 @@
 
 #include <set>
 #include <map>
+#include <unordered_map>
 #include <cstdint>
 #include <vector>
 #include <memory>
+#include <limits>
 #include <graph_iterator.h>
 #include <graph_comparer.h>
+#include <graph_arena.h>
+#include <graph_vertex.h>
+#include <graph_edge.h>
 
 namespace graph
 {
-class vertex;
-class edge;
 
 class graph
 {
 public:
 	graph();
 	graph(const graph&);
+	graph(graph&&);
 	~graph();
 
+	graph& operator=(const graph&);
+	graph& operator=(graph&&);
+
 private:
-	std::map<std::size_t, std::shared_ptr<vertex>> vertices;
-	std::multimap<std::size_t, std::shared_ptr<edge>> edges;
+	//
+	// Topology and attributes of a graph.
+	//
+	struct storage
+	{
+		storage();
+
+		//
+		// Owner of all vertices and edges of this graph.
+		//
+		arena<vertex> vertex_arena;
+		arena<edge> edge_arena;
+
+		//
+		// Vertices with small ids are stored in vertex_table at the position
+		// of their id (nullptr for unused ids). Ids that would make the table
+		// too sparse are stored in sparse_vertices. All sparse ids are greater
+		// or equal than vertex_table.size().
+		//
+		std::vector<vertex*> vertex_table;
+		std::map<std::uint32_t, vertex*> sparse_vertices;
+		std::uint32_t vertex_count;
+
+		//
+		// Largest vertex id + 1
+		//
+		std::uint32_t next_vertex_id;
+
+		//
+		// All edges in insertion order. Every edge knows its position, so
+		// it can be removed by moving the last edge into its place.
+		//
+		std::vector<edge*> edges;
+
+		//
+		// Lookup of the edges by edge::create_key(source_id, target_id).
+		//
+		std::unordered_multimap<std::uint64_t, const edge*> edge_index;
+	};
+
+	storage data;
+
+public:
+	//
+	// Edge description for the bulk build with add_edges.
+	// Remark:
+	// - Attributes with the value NaN are not set on the created edge.
+	//
+	struct edge_record
+	{
+		std::uint32_t source_id;
+		std::uint32_t target_id;
+		double weight = std::numeric_limits<double>::quiet_NaN();
+		double cost = std::numeric_limits<double>::quiet_NaN();
+		double capacity = std::numeric_limits<double>::quiet_NaN();
+	};
 
 public:
 	//
@@ -81,27 +142,53 @@ public:
 		const double cost,
 		const double capacity);
 
+	//
+	// Add many edges at once.
+	// Remark:
+	// - The vertices 0..vertex_count-1 are created, further vertices if an
+	//   edge uses them.
+	// - Undirected edges are added together with their twin.
+	// - Vertices, edges and adjacency lists are allocated once up front
+	//   instead of growing edge by edge.
+	//
+	void add_edges(
+		const std::vector<edge_record>& records,
+		const std::uint32_t vertex_count,
+		const bool create_directed_edges);
+
 	//
 	// Get all edges of the graph.
 	//
 	template<typename E = edge>
-	std::pair<edge_iterator_on_multimap<E>, edge_iterator_on_multimap<E>> get_edges(void) const
+	std::pair<edge_iterator<E, std::vector<edge*>>, edge_iterator<E, std::vector<edge*>>>
+		get_edges(void) const
 	{
 		return std::make_pair(
-			edge_iterator_on_multimap<E>(edges.cbegin()),
-			edge_iterator_on_multimap<E>(edges.cend()));
+			edge_iterator<E, std::vector<edge*>>(data.edges.cbegin()),
+			edge_iterator<E, std::vector<edge*>>(data.edges.cend()));
 	}
 
 	//
-	// Remove an edge from the graph.
+	// Remove an edge of this graph (and its twin) in constant time.
+	// Returns false (and changes nothing) if the edge is not part of this
+	// graph (e.g. an edge of a copy).
 	// Remark:
 	// - Unconnected vertices are not removed.
+	// - Pointers to the other vertices and edges stay valid.
 	//
-	void remove_edge(const edge&);
-
+	bool remove_edge(const edge&);
 
+	//
+	// Remove all edges between the two vertices (both directions).
+	//
 	void remove_edges(const vertex* source, const vertex* target);
 
+	//
+	// Remove a vertex of this graph together with its incoming and
+	// outgoing edges. The cost is linear in the degree of the vertex.
+	//
+	void remove_vertex(const vertex*);
+
 	//
 	// Return a copy of the vertex with the provided vertex id.
 	//
@@ -119,8 +206,14 @@ public:
 	std::pair<vertex_iterator<V>, vertex_iterator<V>> get_vertices(void) const
 	{
 		return std::make_pair(
-			vertex_iterator<V>(vertices.cbegin()),
-			vertex_iterator<V>(vertices.cend()));
+			vertex_iterator<V>(
+				data.vertex_table.cbegin(),
+				data.vertex_table.cend(),
+				data.sparse_vertices.cbegin()),
+			vertex_iterator<V>(
+				data.vertex_table.cend(),
+				data.vertex_table.cend(),
+				data.sparse_vertices.cend()));
 	}
 
 	//
@@ -134,14 +227,47 @@ public:
 	const edge* get_edge(const vertex*, const vertex*) const;
 
 	//
-	//
+	// Returns the edge of the graph with the same source/target ids as the
+	// foreign edge. Without precise_match the direction is ignored.
 	//
 	const edge* get_edge(
 		const edge* foreign_edge, const bool precise_match = true) const;
 
 
 private:
+	//
+	// Copy all vertices and edges (including twins) into this graph.
+	//
+	void copy_from(const storage&);
+
 	vertex* get_vertex_internal(const std::uint32_t) const;
+
+	//
+	// Create a vertex with an unused id in the vertex_table/sparse_vertices.
+	//
+	vertex* create_vertex(const std::uint32_t);
+
+	//
+	// Register a new edge at its source and target vertex, the edge list and
+	// the index.
+	//
+	void insert_edge(vertex* source, vertex* target, edge* new_edge);
+
+	//
+	// Remove an edge from the edge list (not from the vertex or the index).
+	//
+	void erase_edge(const edge*);
+
+	//
+	// Remove an edge from its vertices, the edge list and the index and
+	// return its memory to the edge_arena. The twin is not touched.
+	//
+	void destroy_edge(edge*);
+
+	//
+	// Returns the edge with the key or nullptr. Asserts on parallel edges.
+	//
+	const edge* find_edge(const std::uint64_t key) const;
 };
 
 }
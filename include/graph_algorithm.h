@@ -7,22 +7,72 @@
 #include <map>
 #include <unordered_map>
 #include <list>
+#include <cstddef>
+#include <cstdint>
 
 namespace graph
 {
 class graph;
+class bit_matrix_graph;
+class csr_graph;
+class compressed_graph;
+class disjoint_set;
+class edge_source;
+class thread_pool;
 class vertex;
 class edge;
 struct compare_vertex_id;
 struct undirected_edge_hash;
 struct undirected_edge_equal;
 
+//
+// Degrees of a streamed graph, indexed by vertex id.
+// Remark:
+// - The degree of a vertex is out_degree + in_degree, the degree in the
+//   undirected graph (a loop counts twice).
+//
+struct degree_statistics
+{
+	std::vector<std::uint32_t> out_degrees;
+	std::vector<std::uint32_t> in_degrees;
+	std::uint64_t edge_count = 0;
+	std::uint32_t loop_count = 0;
+	std::uint32_t min_degree = 0;
+	std::uint32_t max_degree = 0;
+	double average_degree = 0.0;
+	std::uint32_t isolated_vertex_count = 0;
+};
+
 class algorithm
 {
 public:
 	algorithm();
 	~algorithm();
 
+	//
+	// Number of threads of the parallel algorithms. The default 0 uses one
+	// thread per hardware thread. The threads are started by the first
+	// large parallel step and reused by the following calls.
+	//
+	void set_thread_count(const std::size_t);
+
+	//
+	// Run the parallel algorithms on the threads of a pool (e.g. shared
+	// with a loader) instead of an own pool, nullptr returns to the own
+	// pool. The pool has to outlive the calls.
+	//
+	void set_thread_pool(thread_pool*);
+
+private:
+	std::size_t _thread_count;
+	thread_pool* _shared_pool;
+	std::unique_ptr<thread_pool> _own_pool;
+
+	//
+	// Returns the pool set by set_thread_pool or the own pool.
+	//
+	thread_pool* get_thread_pool(void);
+
 public:
 	//
 	// Compute and return the spanning tree of a graph from a vertex starting point.
@@ -30,12 +80,127 @@ public:
 	void breadth_first_search(
 		const graph*, const vertex*, graph*);
 
+	//
+	// Breadth first search on a csr snapshot from a start vertex index.
+	// predecessor[i] is the vertex index from which i was discovered
+	// (csr_graph::invalid_index for the start vertex and unreached vertices).
+	//
+	void breadth_first_search(
+		const csr_graph*, const std::uint32_t, std::vector<std::uint32_t>*);
+
+	//
+	// Breadth first search on a compressed graph, same result as for a csr
+	// snapshot (compressed_graph::invalid_index for unreached vertices).
+	//
+	void breadth_first_search(
+		const compressed_graph*, const std::uint32_t, std::vector<std::uint32_t>*);
+
+	//
+	// Breadth first search on a bit matrix graph, same result as for a csr
+	// snapshot. The unvisited neighbors are found 64 at a time
+	// (row and not visited).
+	//
+	void breadth_first_search(
+		const bit_matrix_graph*, const std::uint32_t, std::vector<std::uint32_t>*);
+
+	//
+	// Direction optimizing breadth first search on a csr snapshot, same
+	// result as breadth_first_search up to the choice of the predecessor
+	// within a level.
+	// Remark:
+	// - Small frontiers are expanded top-down (edges of the frontier), large
+	//   frontiers bottom-up: every unvisited vertex looks for a frontier
+	//   vertex among its incoming edges and stops at the first one. Visited
+	//   vertices and the bottom-up frontier are bitmaps.
+	// - incoming is the transposed snapshot (csr_graph::create_transpose) of
+	//   a directed graph, or nullptr if every edge has its twin (undirected
+	//   graph) and the outgoing edges are the incoming edges.
+	// - predecessor_edge (optional) receives the index of the discovering
+	//   edge of every vertex. A bottom-up step finds it in incoming, its
+	//   index is translated by incoming_edge_index (see create_transpose).
+	//   Without incoming it is the reverse edge (vertex to predecessor).
+	//
+	void direction_optimizing_bfs(
+		const csr_graph*,
+		const csr_graph* incoming,
+		const std::uint32_t,
+		std::vector<std::uint32_t>*,
+		std::vector<std::uint32_t>* predecessor_edge = nullptr,
+		const std::vector<std::uint32_t>* incoming_edge_index = nullptr);
+
+	//
+	// Compute the breadth first search spanning tree of a graph from a
+	// vertex starting point with direction_optimizing_bfs. The graph is
+	// copied into a csr snapshot (and its transpose if it has directed
+	// edges) first, so this pays off for large searches. The tree holds
+	// the discovering edges, also in a graph with parallel edges.
+	//
+	void direction_optimizing_bfs(
+		const graph*, const vertex*, graph*);
+
+	//
+	// Level synchronous breadth first search on a csr snapshot, every level
+	// is expanded by all threads (see set_thread_count).
+	// Remark:
+	// - A vertex is claimed by an atomic compare and swap of its
+	//   predecessor, every thread collects its claimed vertices in an own
+	//   buffer and the buffers form the next level.
+	// - The reached vertices and their levels are those of
+	//   breadth_first_search, the predecessor within the previous level
+	//   depends on the thread timing.
+	//
+	void parallel_breadth_first_search(
+		const csr_graph*, const std::uint32_t, std::vector<std::uint32_t>*);
+
+	//
+	// Compute the connected components of an undirected csr snapshot with
+	// parallel_breadth_first_search, numbered like for a compressed graph.
+	//
+	void parallel_connected_component_with_bfs(
+		const csr_graph*, std::vector<std::uint32_t>*, std::uint32_t*);
+
+	//
+	// Compute the connected components of an undirected csr snapshot with
+	// the Afforest algorithm on all threads (see set_thread_count), numbered
+	// like for a compressed graph.
+	// Remark:
+	// - Every vertex points to a parent in an atomic array. Linking two
+	//   trees hooks the larger root below the smaller one by compare and
+	//   swap, compressing lets every vertex point to its root (the smallest
+	//   index of its component).
+	// - The first two neighbors of every vertex are linked first. A sample
+	//   of the labels then finds the largest component, whose vertices skip
+	//   their remaining edges, so most edges of a graph with one giant
+	//   component are never read.
+	//
+	void connected_component_with_afforest(
+		const csr_graph*, std::vector<std::uint32_t>*, std::uint32_t*);
+
 	//
 	// Compute and return the spanning tree of a graph from a vertex starting point.
+	// Remark:
+	// - The path is kept on an explicit stack of edge cursors, so long paths
+	//   need heap memory instead of call stack.
 	//
 	void depth_first_search(
 		const graph*, const vertex*, graph*);
 
+	//
+	// Depth first search on a csr snapshot from a start vertex index.
+	// predecessor is indexed like for breadth_first_search. pre_order[i] and
+	// post_order[i] are the times at which vertex index i is entered and
+	// left (one clock, 0..2*reached-1), so i is an ancestor of j if
+	// pre_order[i] < pre_order[j] and post_order[j] < post_order[i].
+	// Unreached vertices get csr_graph::invalid_index. pre_order and
+	// post_order may be nullptr.
+	//
+	void depth_first_search(
+		const csr_graph*,
+		const std::uint32_t,
+		std::vector<std::uint32_t>* predecessor,
+		std::vector<std::uint32_t>* pre_order,
+		std::vector<std::uint32_t>* post_order);
+
 	//
 	// Compute the connected components of a graph und returning all subgraphs.
 	// Using the breadth first search spanning tree algorithm.
@@ -50,16 +215,94 @@ public:
 	void connected_component_with_dfs(
 		const graph*, std::vector<std::shared_ptr<graph>>*);
 
+	//
+	// Compute the connected components of a stream of edges with union-find.
+	// Afterwards every vertex id is an element of components, vertices of a
+	// component share the representative.
+	// Returns false if the source could not be read.
+	//
+	bool connected_component_with_union_find(edge_source*, disjoint_set*);
+
+	//
+	// Compute the connected components of a graph with union-find, the
+	// edges are taken as undirected. Nothing but a label per vertex is
+	// created.
+	// Remark:
+	// - Vertices are addressed by a dense index in the order of
+	//   graph::get_vertices (ascending id), like the csr_graph index.
+	// - component[i] is the number [0, component_sizes.size()) of the component of
+	//   vertex index i, numbered in the order of their smallest index.
+	//   component_sizes holds the number of vertices of every component.
+	//
+	void connected_component_with_union_find(
+		const graph*,
+		std::vector<std::uint32_t>* component,
+		std::vector<std::uint32_t>* component_sizes);
+
+	//
+	// Copy the components of a graph labelled by
+	// connected_component_with_union_find into one subgraph each, with all
+	// vertices (and balances) and all edges of the component.
+	//
+	void create_component_subgraphs(
+		const graph*,
+		const std::vector<std::uint32_t>& component,
+		const std::uint32_t component_count,
+		std::vector<std::shared_ptr<graph>>*);
+
+	//
+	// Compute the connected components of an undirected compressed graph.
+	// component[i] is the number [0, component_count) of the component of
+	// vertex index i, numbered in the order of their smallest index.
+	//
+	void connected_component_with_bfs(
+		const compressed_graph*, std::vector<std::uint32_t>*, std::uint32_t*);
+
+	//
+	// Compute the connected components of an undirected bit matrix graph,
+	// numbered like for a compressed graph.
+	//
+	void connected_component_with_bfs(
+		const bit_matrix_graph*, std::vector<std::uint32_t>*, std::uint32_t*);
+
 	//
 	// Find the minimal spanning tree with the prim algorithm.
 	//
 	void prim(const graph*, const vertex*, graph*, double*);
 
+	//
+	// Find the minimal spanning tree of a csr snapshot with the prim algorithm.
+	// predecessor[i] is the vertex index that connects i to the tree.
+	//
+	void prim(
+		const csr_graph*,
+		const std::uint32_t,
+		std::vector<std::uint32_t>*,
+		double*);
+
 	//
 	// Find the minimal spanning tree with the kruskal algorithm.
 	//
 	void kruskal(const graph*, graph*, double*);
 
+	//
+	// Kruskal on a stream of edges sorted by ascending weight, e.g. an edge
+	// list too large for memory. Only the union-find state and the tree are
+	// kept. The stream is stopped once the tree spans all vertices.
+	// Returns false if the source could not be read.
+	// Remark:
+	// - The stream has to be sorted by weight, it is not sorted here. If a
+	//   weight decreases (or is missing), false is returned and no tree
+	//   edge is added.
+	//
+	bool kruskal(edge_source*, graph*, double*);
+
+	//
+	// Count the degrees of every vertex in one pass over a stream of edges.
+	// Returns false if the source could not be read.
+	//
+	bool compute_degree_statistics(edge_source*, degree_statistics*);
+
 	//
 	// Nearest neighbor
 	//
@@ -85,6 +328,17 @@ public:
 		std::unordered_map<std::uint32_t, double>* distances,
 		bool* negative_weights_found);
 
+	//
+	// Dijkstra-Algorithm on a csr snapshot. All outputs are indexed by the
+	// dense vertex index.
+	//
+	void dijkstra(
+		const csr_graph* full_graph,
+		const std::uint32_t start_index,
+		std::vector<std::uint32_t>* predecessor,
+		std::vector<double>* distances,
+		bool* negative_weights_found);
+
 	//
 	// Moore-Bellman-Ford-Algorithm
 	//
@@ -95,6 +349,17 @@ public:
 		std::unordered_map<std::uint32_t, double>* distances,
 		bool* negative_cycle_found);
 
+	//
+	// Moore-Bellman-Ford-Algorithm on a csr snapshot. Uses the cost of an
+	// edge, or the weight if the snapshot has no costs.
+	//
+	void moore_bellman_ford(
+		const csr_graph* g,
+		const std::uint32_t start_index,
+		std::vector<std::uint32_t>* predecessor,
+		std::vector<double>* distances,
+		bool* negative_cycle_found);
+
 	//
 	// Edmonds-Karp
 	//
@@ -162,12 +427,6 @@ public:
 		const graph* g, const uint32_t set_seperator, double* maximal_matchings);
 
 private:
-	void depth_first_search_recursive(
-		const graph*,
-		const vertex*,
-		std::set<const vertex*, compare_vertex_id>*,
-		graph* );
-
 	//
 	// Compute the connected components of a graph und returning all subgraphs.
 	//
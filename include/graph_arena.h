@@ -0,0 +1,203 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace graph
+{
+
+//
+// Slab allocator for the vertices and edges owned by a graph.
+// Remark:
+// - Objects are constructed in large chunks instead of one heap allocation
+//   per object.
+// - The addresses of created objects never change.
+// - Destroyed objects leave their slot to the next created object.
+// - All objects are destroyed and released in bulk with the arena.
+//
+template<typename T>
+class arena
+{
+private:
+	typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type slot;
+
+	struct chunk
+	{
+		std::unique_ptr<slot[]> memory;
+		std::size_t used;
+		std::size_t capacity;
+	};
+
+	std::vector<chunk> _chunks;
+
+	//
+	// Slots of destroyed objects, reused before a chunk grows.
+	//
+	std::vector<slot*> _free;
+
+	//
+	// Capacity of the next chunk. Grows up to max_chunk_size.
+	//
+	std::size_t _next_chunk_size;
+
+	static const std::size_t min_chunk_size = 64;
+	static const std::size_t max_chunk_size = 64 * 1024;
+
+public:
+	arena()
+		:
+		_next_chunk_size(min_chunk_size)
+	{
+	}
+
+	arena(const arena&) = delete;
+	arena& operator=(const arena&) = delete;
+
+	arena(arena&& rhs)
+		:
+		_chunks(std::move(rhs._chunks)),
+		_free(std::move(rhs._free)),
+		_next_chunk_size(rhs._next_chunk_size)
+	{
+		rhs._chunks.clear();
+		rhs._free.clear();
+		rhs._next_chunk_size = min_chunk_size;
+	}
+
+	arena& operator=(arena&& rhs)
+	{
+		if(this != &rhs)
+		{
+			clear();
+			_chunks = std::move(rhs._chunks);
+			_free = std::move(rhs._free);
+			_next_chunk_size = rhs._next_chunk_size;
+			rhs._chunks.clear();
+			rhs._free.clear();
+			rhs._next_chunk_size = min_chunk_size;
+		}
+		return *this;
+	}
+
+	~arena()
+	{
+		clear();
+	}
+
+public:
+	//
+	// Construct a new object inside the arena.
+	//
+	template<typename... Args>
+	T* create(Args&&... args)
+	{
+		if(!_free.empty())
+		{
+			T* result = new(_free.back()) T(std::forward<Args>(args)...);
+			_free.pop_back();
+			return result;
+		}
+
+		if(_chunks.empty() || _chunks.back().used == _chunks.back().capacity)
+			add_chunk(_next_chunk_size);
+
+		chunk& c = _chunks.back();
+		T* result = new(&c.memory[c.used]) T(std::forward<Args>(args)...);
+		++c.used;
+
+		return result;
+	}
+
+	//
+	// Destroy an object of this arena, its slot is reused.
+	//
+	void destroy(T* object)
+	{
+		object->~T();
+		_free.push_back(reinterpret_cast<slot*>(object));
+	}
+
+	//
+	// Make sure that the next count objects are created without allocation.
+	// Only the missing slots are allocated.
+	//
+	void reserve(const std::size_t count)
+	{
+		std::size_t available = _free.size();
+
+		if(!_chunks.empty())
+			available += _chunks.back().capacity - _chunks.back().used;
+
+		if(available >= count)
+			return;
+
+		// The rest of the current chunk would be lost behind the new one,
+		// so its slots are moved to the free slots (lowest address last).
+		if(!_chunks.empty())
+		{
+			chunk& c = _chunks.back();
+
+			for(std::size_t i = c.capacity; i > c.used; --i)
+				_free.push_back(&c.memory[i - 1]);
+			c.used = c.capacity;
+		}
+
+		add_chunk(count - available);
+	}
+
+	//
+	// Returns the number of slots of all chunks.
+	//
+	std::size_t get_capacity(void) const
+	{
+		std::size_t capacity = 0;
+
+		for(const chunk& c : _chunks)
+			capacity += c.capacity;
+
+		return capacity;
+	}
+
+	//
+	// Destroy all objects and release the memory.
+	//
+	void clear(void)
+	{
+		// Destroyed objects must not be destroyed twice.
+		std::sort(_free.begin(), _free.end(), std::less<slot*>());
+
+		for(chunk& c : _chunks)
+		{
+			for(std::size_t i = 0; i < c.used; ++i)
+			{
+				slot* s = &c.memory[i];
+
+				if(!std::binary_search(_free.begin(), _free.end(), s, std::less<slot*>()))
+					reinterpret_cast<T*>(s)->~T();
+			}
+		}
+		_chunks.clear();
+		_free.clear();
+		_next_chunk_size = min_chunk_size;
+	}
+
+private:
+	void add_chunk(const std::size_t capacity)
+	{
+		chunk c;
+		c.memory.reset(new slot[capacity]);
+		c.used = 0;
+		c.capacity = capacity;
+		_chunks.push_back(std::move(c));
+
+		if(_next_chunk_size < max_chunk_size)
+			_next_chunk_size *= 2;
+	}
+};
+
+}
@@ -0,0 +1,151 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace graph
+{
+class edge_source;
+
+//
+// Dense unweighted graph stored as adjacency bit matrix.
+// Remark:
+// - Row i holds one bit per vertex, bit j is set for an edge i -> j. The
+//   rows are padded to whole 64 bit words, so the matrix takes about
+//   vertex_count^2 / 8 bytes, independent of the edge count.
+// - Neighbor sets are combined a word at a time (and, or, popcount), so
+//   traversals on dense graphs touch 64 vertices per operation.
+// - Vertices are addressed by a dense index [0, vertex_count).
+//
+class bit_matrix_graph
+{
+public:
+	typedef std::uint64_t word;
+
+	static const std::size_t word_bits = 64;
+
+	bit_matrix_graph();
+	bit_matrix_graph(const std::uint32_t vertex_count);
+
+	//
+	// Set the edges of a source (e.g. loader::open_edge_source(files::Graph1)),
+	// undirected edges are set in both directions.
+	// Remark:
+	// - If the source could not be read or an edge uses a vertex id beyond
+	//   the announced vertex count, the graph is empty and is_valid returns
+	//   false.
+	//
+	bit_matrix_graph(edge_source*, const bool create_directed_graph = false);
+
+	~bit_matrix_graph();
+
+private:
+	std::uint32_t _vertex_count;
+	std::size_t _word_count;
+	std::vector<word> _bits;
+
+	//
+	// False if the edge source of the constructor could not be read.
+	//
+	bool _valid;
+
+public:
+	//
+	// Marks an unknown vertex index.
+	//
+	static const std::uint32_t invalid_index =
+		std::numeric_limits<std::uint32_t>::max();
+
+	//
+	// Returns false if the edge source could not be read.
+	//
+	bool is_valid(void) const;
+
+	//
+	// Returns the number of vertices/edges (set bits).
+	//
+	std::uint32_t get_vertex_count(void) const;
+	std::uint64_t get_edge_count(void) const;
+
+	//
+	// Returns the number of words of a row.
+	//
+	std::size_t get_word_count(void) const
+	{
+		return _word_count;
+	}
+
+	//
+	// Returns the words of the row of a vertex index.
+	//
+	const word* get_row(const std::uint32_t index) const
+	{
+		return _bits.data() + index * _word_count;
+	}
+
+	//
+	// Set or check the edge source -> target.
+	//
+	void set_edge(const std::uint32_t source, const std::uint32_t target)
+	{
+		_bits[source * _word_count + target / word_bits] |= word(1) << (target % word_bits);
+	}
+
+	bool has_edge(const std::uint32_t source, const std::uint32_t target) const
+	{
+		return (get_row(source)[target / word_bits] >> (target % word_bits)) & 1;
+	}
+
+	//
+	// Returns the number of outgoing edges of a vertex index (popcount of
+	// the row).
+	//
+	std::uint32_t get_degree(const std::uint32_t index) const;
+
+	//
+	// Returns the number of vertices adjacent to both vertex indices
+	// (popcount of the and of both rows).
+	//
+	std::uint32_t get_common_neighbor_count(
+		const std::uint32_t, const std::uint32_t) const;
+
+	//
+	// Call f(index) for the index of every set bit of a word array.
+	//
+	template<typename F>
+	static void for_each_bit(const word* words, const std::size_t word_count, F f)
+	{
+		for(std::size_t w = 0; w < word_count; ++w)
+		{
+			for(word bits = words[w]; bits != 0; bits &= bits - 1)
+				f(static_cast<std::uint32_t>(w * word_bits + count_trailing_zeros(bits)));
+		}
+	}
+
+	//
+	// Bit operations of a single word.
+	//
+	static std::uint32_t popcount(const word value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<std::uint32_t>(__builtin_popcountll(value));
+#else
+		word v = value - ((value >> 1) & 0x5555555555555555ULL);
+		v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+		v = (v + (v >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+		return static_cast<std::uint32_t>((v * 0x0101010101010101ULL) >> 56);
+#endif
+	}
+
+	static std::uint32_t count_trailing_zeros(const word value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<std::uint32_t>(__builtin_ctzll(value));
+#else
+		return popcount((value & (0 - value)) - 1);
+#endif
+	}
+};
+
+}
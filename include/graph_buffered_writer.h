@@ -0,0 +1,120 @@
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace graph
+{
+
+//
+// Writes numbers and raw bytes into a file through a large buffer.
+// Remark:
+// - Numbers are formatted with std::to_chars, independent of the locale
+//   and without streams. Doubles are written in the shortest form that
+//   reads back to the same value (see text_parser).
+// - The buffer is handed to the file in blocks of buffer_size bytes, so
+//   a line costs no stream call.
+// - Write errors are not reported while writing: a failed flush of the
+//   buffer only sets the error state of the stream, later writes go on.
+//   close reports them, so its result has to be checked. The destructor
+//   closes the file without a report.
+//
+class buffered_writer
+{
+public:
+	static const std::size_t buffer_size = std::size_t(1) << 20;
+
+	//
+	// Open (and truncate) a file for writing.
+	//
+	buffered_writer(const std::string& file_name);
+	buffered_writer(const buffered_writer&) = delete;
+	buffered_writer& operator=(const buffered_writer&) = delete;
+	~buffered_writer();
+
+private:
+	std::ofstream _stream;
+	std::vector<char> _buffer;
+	std::size_t _size;
+
+	//
+	// Longest text of a single number written by to_chars.
+	//
+	static const std::size_t max_number_length = 32;
+
+public:
+	//
+	// Returns true if the file was opened.
+	//
+	bool is_open(void) const;
+
+	//
+	// Write the buffer into the file and close it.
+	// Returns false if any write failed.
+	//
+	bool close(void);
+
+	//
+	// Write a number as text.
+	//
+	void write(const std::uint32_t value)
+	{
+		write_number(value);
+	}
+
+	void write(const std::uint64_t value)
+	{
+		write_number(value);
+	}
+
+	void write(const double value)
+	{
+		write_number(value);
+	}
+
+	//
+	// Write text.
+	//
+	void write(const char value)
+	{
+		if(_size == _buffer.size())
+			flush();
+
+		_buffer[_size++] = value;
+	}
+
+	void write(const std::string_view value)
+	{
+		write_bytes(value.data(), value.size());
+	}
+
+	//
+	// Write raw bytes (binary formats).
+	//
+	void write_bytes(const void* data, const std::size_t size);
+
+private:
+	template<typename T>
+	void write_number(const T value)
+	{
+		if(_buffer.size() - _size < max_number_length)
+			flush();
+
+		char* begin = _buffer.data() + _size;
+		const std::to_chars_result result =
+			std::to_chars(begin, begin + max_number_length, value);
+
+		_size += result.ptr - begin;
+	}
+
+	//
+	// Hand the buffered bytes to the file.
+	//
+	void flush(void);
+};
+
+}
@@ -0,0 +1,209 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <graph_iterator.h>
+
+namespace graph
+{
+class csr_graph;
+class edge_source;
+
+//
+// Immutable unweighted graph whose neighbor lists are stored compressed.
+// Remark:
+// - Vertices are addressed by a dense index [0, vertex_count), the csr
+//   index or the vertex id of an edge_source.
+// - Every neighbor list is sorted and gap encoded with variable length
+//   integers (7 bits per byte, LEB128): the degree, the first neighbor as
+//   zigzag encoded difference to the vertex itself and then the gaps to
+//   the previous neighbor. Sparse graphs with local ids need 1-2 bytes
+//   per edge instead of 4 (csr_graph) or the edge objects of graph.
+// - The lists are decoded on the fly by neighbor_iterator, so only
+//   traversals without edge attributes (BFS, components) can use it.
+//
+class compressed_graph
+{
+public:
+	//
+	// Decodes the neighbor list of a vertex.
+	//
+	class neighbor_iterator
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef std::uint32_t value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const std::uint32_t* pointer;
+		typedef const std::uint32_t& reference;
+
+		neighbor_iterator()
+			:
+			_position(nullptr),
+			_remaining(0),
+			_current(0)
+		{
+		}
+
+		neighbor_iterator(
+			const std::uint8_t* position,
+			const std::uint32_t remaining,
+			const std::uint32_t vertex)
+			:
+			_position(position),
+			_remaining(remaining),
+			_current(0)
+		{
+			if(_remaining != 0)
+			{
+				const std::uint64_t zigzag = read_varint(&_position);
+				const std::int64_t difference =
+					static_cast<std::int64_t>(zigzag >> 1) ^ -static_cast<std::int64_t>(zigzag & 1);
+
+				_current = static_cast<std::uint32_t>(vertex + difference);
+			}
+		}
+
+	private:
+		const std::uint8_t* _position;
+		std::uint32_t _remaining;
+		std::uint32_t _current;
+
+	public:
+		reference operator*() const
+		{
+			return _current;
+		}
+
+		neighbor_iterator& operator++()
+		{
+			if(--_remaining != 0)
+				_current += static_cast<std::uint32_t>(read_varint(&_position));
+			return *this;
+		}
+
+		neighbor_iterator operator++(int)
+		{
+			neighbor_iterator result(*this);
+			++(*this);
+			return result;
+		}
+
+		//
+		// Only iterators of the same list can be compared.
+		//
+		bool operator==(const neighbor_iterator& rhs) const
+		{
+			return _remaining == rhs._remaining;
+		}
+
+		bool operator!=(const neighbor_iterator& rhs) const
+		{
+			return _remaining != rhs._remaining;
+		}
+	};
+
+public:
+	compressed_graph();
+
+	//
+	// Compress the outgoing edges of a csr snapshot.
+	//
+	compressed_graph(const csr_graph*);
+
+	//
+	// Compress a stream of edges without building a graph. The source is
+	// read twice (degrees, then neighbors), undirected edges are stored in
+	// both directions.
+	// Remark:
+	// - If the source could not be read (or delivered other edges on the
+	//   second read), the graph is empty and is_valid returns false.
+	//
+	compressed_graph(edge_source*, const bool create_directed_graph = false);
+
+	~compressed_graph();
+
+private:
+	//
+	// Byte position of every neighbor list, vertex_count + 1 entries.
+	//
+	std::vector<std::uint64_t> _offsets;
+	std::vector<std::uint8_t> _data;
+	std::uint64_t _edge_count;
+
+	//
+	// False if the edge source of the constructor could not be read.
+	//
+	bool _valid;
+
+public:
+	//
+	// Marks an unknown vertex index.
+	//
+	static const std::uint32_t invalid_index =
+		std::numeric_limits<std::uint32_t>::max();
+
+	//
+	// Returns false if the edge source could not be read.
+	//
+	bool is_valid(void) const;
+
+	//
+	// Returns the number of vertices/edges.
+	//
+	std::uint32_t get_vertex_count(void) const;
+	std::uint64_t get_edge_count(void) const;
+
+	//
+	// Returns the number of neighbors of a vertex index.
+	//
+	std::uint32_t get_degree(const std::uint32_t index) const;
+
+	//
+	// Returns the sorted neighbor indices of a vertex index (usable in a
+	// range based for loop, see graph_iterator.h).
+	//
+	std::pair<neighbor_iterator, neighbor_iterator> get_neighbors(
+		const std::uint32_t index) const;
+
+	//
+	// Returns the bytes used by the compressed lists and their offsets.
+	//
+	std::size_t get_memory_size(void) const;
+
+	//
+	// Variable length integer coding used by the lists.
+	//
+	static void write_varint(std::uint64_t value, std::vector<std::uint8_t>* data);
+	static std::uint64_t read_varint(const std::uint8_t** position)
+	{
+		std::uint64_t value = 0;
+		unsigned shift = 0;
+
+		while(true)
+		{
+			const std::uint8_t byte = *(*position)++;
+
+			value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+			if((byte & 0x80) == 0)
+				return value;
+
+			shift += 7;
+		}
+	}
+
+private:
+	//
+	// Sort the neighbors of every vertex and encode them.
+	// neighbors holds the lists of all vertices at the given offsets.
+	//
+	void encode(
+		const std::vector<std::uint64_t>& offsets,
+		std::vector<std::uint32_t>* neighbors);
+};
+
+}
@@ -0,0 +1,201 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <limits>
+#include <memory>
+#include <string>
+
+namespace graph
+{
+class graph;
+class mapped_file;
+
+//
+// Immutable compressed sparse row (CSR) snapshot of a graph.
+// Remark:
+// - Vertices are addressed by a dense index [0, vertex_count) in the order
+//   of graph::get_vertices (ascending id).
+// - The outgoing edges of the vertex with index i are stored in the range
+//   [get_edge_begin(i), get_edge_end(i)) of the contiguous edge arrays.
+// - Attributes that no edge/vertex of the source graph carries are not
+//   stored. Missing values of a stored attribute are NaN.
+// - The arrays are either owned by the csr_graph or are part of a memory
+//   mapped snapshot file (see write_snapshot/read_snapshot).
+//
+class csr_graph
+{
+public:
+	csr_graph();
+	csr_graph(const graph*);
+	csr_graph(const csr_graph&);
+	csr_graph(csr_graph&&);
+	~csr_graph();
+
+	csr_graph& operator=(const csr_graph&);
+	csr_graph& operator=(csr_graph&&);
+
+private:
+	//
+	// Vertex id of every vertex index (ascending).
+	//
+	std::vector<std::uint32_t> _ids;
+
+	//
+	// Edge range of every vertex index, vertex_count + 1 entries.
+	//
+	std::vector<std::uint32_t> _offsets;
+
+	//
+	// Target vertex index of every edge.
+	//
+	std::vector<std::uint32_t> _targets;
+
+	std::vector<double> _weights;
+	std::vector<double> _costs;
+	std::vector<double> _capacities;
+	std::vector<double> _balances;
+
+	//
+	// Snapshot file that holds the arrays, nullptr if the arrays are owned.
+	//
+	std::shared_ptr<const mapped_file> _file;
+
+	//
+	// The arrays used by all accessors. They point into the vectors above
+	// or into the snapshot file. Attributes that are not stored are nullptr.
+	//
+	std::uint32_t _vertex_count;
+	std::uint32_t _edge_count;
+	const std::uint32_t* _id_data;
+	const std::uint32_t* _offset_data;
+	const std::uint32_t* _target_data;
+	const double* _weight_data;
+	const double* _cost_data;
+	const double* _capacity_data;
+	const double* _balance_data;
+
+public:
+	//
+	// Marks an unknown vertex or edge index.
+	//
+	static const std::uint32_t invalid_index =
+		std::numeric_limits<std::uint32_t>::max();
+
+	//
+	// Version of the snapshot format written by write_snapshot.
+	//
+	static const std::uint32_t snapshot_version = 1;
+
+	//
+	// Write the arrays into a binary snapshot file.
+	// Returns false if the file could not be written.
+	//
+	bool write_snapshot(const std::string& file_name) const;
+
+	//
+	// Map a snapshot file written by write_snapshot without parsing or
+	// copying the arrays. Returns false (and leaves result unchanged) if the
+	// file is missing, truncated, of another version/byte order or has
+	// unknown attributes, or if the offsets, targets or ids are invalid.
+	// Remark:
+	// - The arrays are checked once in O(n + m).
+	//
+	static bool read_snapshot(const std::string& file_name, csr_graph* result);
+
+	//
+	// Create the snapshot with all edges reversed (same vertex indices), so
+	// the outgoing edges of a vertex index are its incoming edges here.
+	// The edge attributes move with the edges. edge_index (optional)
+	// receives the edge index in this snapshot of every reversed edge.
+	//
+	void create_transpose(
+		csr_graph* result, std::vector<std::uint32_t>* edge_index = nullptr) const;
+
+	//
+	// Returns the number of vertices/edges.
+	//
+	std::uint32_t get_vertex_count(void) const;
+	std::uint32_t get_edge_count(void) const;
+
+	//
+	// Translate between vertex id and dense vertex index.
+	// get_index returns invalid_index if the id is not part of the graph.
+	//
+	std::uint32_t get_index(const std::uint32_t id) const;
+	std::uint32_t get_id(const std::uint32_t index) const;
+
+	//
+	// Returns the range of the outgoing edges of a vertex index.
+	//
+	std::uint32_t get_edge_begin(const std::uint32_t index) const
+	{
+		return _offset_data[index];
+	}
+
+	std::uint32_t get_edge_end(const std::uint32_t index) const
+	{
+		return _offset_data[index + 1];
+	}
+
+	std::uint32_t get_degree(const std::uint32_t index) const
+	{
+		return _offset_data[index + 1] - _offset_data[index];
+	}
+
+	//
+	// Returns the target vertex index of an edge index.
+	//
+	std::uint32_t get_target(const std::uint32_t edge_index) const
+	{
+		return _target_data[edge_index];
+	}
+
+	//
+	// Check and Get the edge attributes.
+	//
+	bool has_weights(void) const;
+	double get_weight(const std::uint32_t edge_index) const
+	{
+		return _weight_data[edge_index];
+	}
+
+	bool has_costs(void) const;
+	double get_cost(const std::uint32_t edge_index) const
+	{
+		return _cost_data[edge_index];
+	}
+
+	bool has_capacities(void) const;
+	double get_capacity(const std::uint32_t edge_index) const
+	{
+		return _capacity_data[edge_index];
+	}
+
+	//
+	// Check and Get the vertex balance.
+	//
+	bool has_balances(void) const;
+	double get_balance(const std::uint32_t index) const
+	{
+		return _balance_data[index];
+	}
+
+	//
+	// Direct access to the contiguous arrays.
+	//
+	const std::uint32_t* get_offsets(void) const;
+	const std::uint32_t* get_targets(void) const;
+
+private:
+	//
+	// Point the arrays to the owned vectors.
+	//
+	void use_vectors(void);
+
+	//
+	// Point the arrays to the arrays of another graph (mapped snapshot).
+	//
+	void use_arrays(const csr_graph&);
+};
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace graph
+{
+
+//
+// Union-find structure over the elements [0, size).
+// Remark:
+// - Union by size and path halving, so find and unite are nearly O(1).
+// - Elements are plain indices (e.g. vertex ids), unite grows the
+//   structure for indices beyond the current size.
+//
+class disjoint_set
+{
+public:
+	disjoint_set(const std::uint32_t size = 0);
+	~disjoint_set();
+
+private:
+	std::vector<std::uint32_t> _parents;
+	std::vector<std::uint32_t> _sizes;
+	std::uint32_t _set_count;
+
+public:
+	//
+	// Add singleton sets until the structure holds size elements.
+	//
+	void grow(const std::uint32_t size);
+
+	//
+	// Returns the representative of the set of an element.
+	//
+	std::uint32_t find(std::uint32_t element);
+
+	//
+	// Merge the sets of two elements.
+	// Returns false if both already were in the same set.
+	//
+	bool unite(const std::uint32_t, const std::uint32_t);
+
+	//
+	// Returns the number of elements/sets.
+	//
+	std::uint32_t get_size(void) const;
+	std::uint32_t get_set_count(void) const;
+
+	//
+	// Returns the number of elements in the set of an element.
+	//
+	std::uint32_t get_set_size(const std::uint32_t element);
+};
+
+}
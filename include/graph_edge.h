@@ -2,10 +2,12 @@
 #include <cstdint>
 #include <memory>
 #include <cassert>
+#include <graph_iterator.h>
 
 namespace graph
 {
 class vertex;
+class graph;
 
 class edge
 {
@@ -14,30 +16,53 @@ private:
 	const vertex* _target;
 	const edge* _twin;
 
-	std::unique_ptr<double> _weight;
-	std::unique_ptr<double> _cost;
-	std::unique_ptr<double> _capacity;
+	//
+	// Attributes are stored inline, _attributes marks the present ones.
+	//
+	double _weight;
+	double _cost;
+	double _capacity;
+	std::uint8_t _attributes;
+
+	enum attribute : std::uint8_t
+	{
+		attribute_weight = 1 << 0,
+		attribute_cost = 1 << 1,
+		attribute_capacity = 1 << 2,
+	};
+
+	//
+	// Position of this edge in the edge list of the owning graph.
+	//
+	std::uint32_t _position;
+
+	//
+	// Position of this edge in the edges of the source and in the pointing
+	// edges of the target vertex. Maintained by the vertices, which only
+	// hold const edges.
+	//
+	mutable std::uint32_t _out_position;
+	mutable std::uint32_t _in_position;
+
+	friend class graph;
+	friend class vertex;
 
 public:
 	edge(void);
 	edge(const edge&) = delete;
-	~edge();
+	virtual ~edge();
 
 public:
 	template<typename V = vertex>
 	const V* get_source(void) const
 	{
-		const V* result = dynamic_cast<const V*>(_source);
-		assert(result);
-		return result;
+		return element_cast<V, vertex>::apply(_source);
 	}
 
 	template<typename V = vertex>
 	const V* get_target(void) const
 	{
-		const V* result = dynamic_cast<const V*>(_target);
-		assert(result);
-		return result;
+		return element_cast<V, vertex>::apply(_target);
 	}
 
 	void set_source(const vertex*);
@@ -60,12 +85,33 @@ public:
 	double get_capacity(void) const;
 	void set_capacity(const double);
 
+	//
+	// Copy weight, cost and capacity (not the vertices or the twin).
+	//
+	void assign_attributes(const edge*);
+
 	std::shared_ptr<edge> create_copy(void) const;
 
 	std::size_t get_hash(void) const;
 
 public:
+	//
+	// Returns the hash of the undirected edge, equal for (a,b) and (b,a).
+	//
 	static std::size_t create_hash(const edge*);
+	static std::size_t create_hash(const std::uint32_t, const std::uint32_t);
+
+	//
+	// Packs the vertex ids of a directed edge into one 64 bit key.
+	// The source id is stored in the upper, the target id in the lower half.
+	//
+	static std::uint64_t create_key(const std::uint32_t, const std::uint32_t);
+
+	//
+	// Same as create_key, but the smaller vertex id is always the source.
+	//
+	static std::uint64_t create_undirected_key(
+		const std::uint32_t, const std::uint32_t);
 };
 
 }
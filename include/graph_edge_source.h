@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include <graph.h>
+#include <graph_mapped_file.h>
+
+namespace graph
+{
+
+//
+// Receives the edges of an edge_source one by one.
+// Returns false to stop the stream.
+//
+typedef std::function<bool(const graph::edge_record&)> edge_consumer;
+
+//
+// Sequence of edges that is pushed to a consumer without building a graph.
+// Remark:
+// - Algorithms that only need a single pass over the edges accept an
+//   edge_source, so their memory use is their own state.
+// - Undirected edges are reported once, in one direction.
+//
+class edge_source
+{
+public:
+	virtual ~edge_source();
+
+	//
+	// Returns the number of vertices announced by the source. Vertex ids
+	// are expected in [0, vertex_count), but edges may use larger ids.
+	//
+	virtual std::uint32_t get_vertex_count(void) const = 0;
+
+	//
+	// Push every edge to the consumer in the order of the source.
+	// Returns false if the source could not be read completely (a stop
+	// requested by the consumer is not an error).
+	//
+	virtual bool read_edges(const edge_consumer&) = 0;
+};
+
+//
+// Layouts of the text files in graph/.
+//
+enum class edge_format
+{
+	// vertex count, vertex count x vertex count 0/1 matrix
+	adjacent_matrix,
+	// vertex count, "source target" lines
+	edge_list,
+	// vertex count, "source target weight" lines
+	edge_list_weighted,
+	// vertex count, one balance per vertex, "source target cost capacity" lines
+	edge_list_minimum_cost_flow,
+	// vertex count, set separator, "source target" lines
+	edge_list_matching
+};
+
+//
+// Streams the edges of a text file.
+// Remark:
+// - The file is memory mapped and parsed sequentially on every
+//   read_edges, so the file can be larger than the memory.
+// - Balances of a minimum cost flow file are skipped.
+//
+class file_edge_source : public edge_source
+{
+public:
+	file_edge_source(const std::string& file_name, const edge_format format);
+	~file_edge_source();
+
+private:
+	const mapped_file _file;
+	const edge_format _format;
+	std::uint32_t _vertex_count;
+
+	//
+	// Start of the edge data (after the header).
+	//
+	const char* _edges;
+	bool _valid;
+
+public:
+	std::uint32_t get_vertex_count(void) const override;
+	bool read_edges(const edge_consumer&) override;
+};
+
+}
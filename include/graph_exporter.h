@@ -0,0 +1,123 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <graph_comparer.h>
+
+namespace graph
+{
+class graph;
+class edge;
+enum class edge_format;
+
+//
+// Writes graphs and algorithm results into files.
+// Remark:
+// - All files go through a buffered_writer, so exporting costs about as
+//   much as reading the same file with the loader.
+// - Undirected edges (edges with a twin) are written once.
+// - Text numbers are written in the shortest form that reads back to the
+//   same value, unreachable distances as "inf".
+// - Returns false if a file could not be written.
+//
+class exporter
+{
+public:
+	exporter();
+	~exporter();
+
+public:
+	//
+	// Header of the binary result files.
+	// Remark:
+	// - Followed by count doubles (distances) or count flow_records (flow).
+	// - Native byte order, like the csr snapshot.
+	//
+	struct result_header
+	{
+		char magic[4];
+		std::uint32_t version;
+		std::uint32_t kind;
+		std::uint32_t reserved;
+		std::uint64_t count;
+	};
+
+	struct flow_record
+	{
+		std::uint32_t source_id;
+		std::uint32_t target_id;
+		double flow;
+	};
+
+	static const char result_magic[4];
+	static const std::uint32_t result_version = 1;
+	static const std::uint32_t result_distances = 1;
+	static const std::uint32_t result_flow = 2;
+
+	typedef std::unordered_map<
+		const edge*,
+		double,
+		undirected_edge_hash,
+		undirected_edge_equal> flow_map;
+
+public:
+	//
+	// Trivial Graph Format: "id label" per vertex, "#", "source target label"
+	// per edge. The labels follow the yEd files in graph/: "id/balance" for
+	// balanced vertices, "capacity/cost" or the weight for edges.
+	// Returns false (without writing) if an edge has only one of capacity
+	// and cost.
+	//
+	bool save_tgf(const std::string& file_name, const graph& graph);
+
+	//
+	// Text edge list in one of the layouts of the files in graph/, readable
+	// by file_edge_source. The vertex count is the largest id + 1.
+	// Supported are edge_list, edge_list_weighted and
+	// edge_list_minimum_cost_flow, false is returned for the others and
+	// (without writing) if an edge lacks the weight or cost/capacity of
+	// the format.
+	//
+	bool save_edge_list(
+		const std::string& file_name,
+		const graph& graph,
+		const edge_format format);
+
+	//
+	// Binary graph, the csr snapshot of loader::save_snapshot.
+	//
+	bool save_binary(const std::string& file_name, const graph& graph);
+
+	//
+	// Distances of a shortest path algorithm. The text files hold
+	// "id distance" lines sorted by id. The vector form (csr algorithms) is
+	// indexed by the dense vertex index, its text file holds the count and
+	// then one distance per line.
+	//
+	bool save_distances(
+		const std::string& file_name,
+		const std::unordered_map<std::uint32_t, double>& distances);
+	bool save_distances(
+		const std::string& file_name,
+		const std::vector<double>& distances);
+	bool save_distances_binary(
+		const std::string& file_name,
+		const std::vector<double>& distances);
+
+	//
+	// Flow per edge of a flow algorithm (edmonds_karp, cycle_cancelling,
+	// ...), "source target flow" lines sorted by source and target.
+	//
+	bool save_flow(const std::string& file_name, const flow_map& flow_per_edge);
+	bool save_flow_binary(const std::string& file_name, const flow_map& flow_per_edge);
+
+private:
+	//
+	// Returns the flow records sorted by source and target.
+	//
+	static std::vector<flow_record> get_flow_records(const flow_map& flow_per_edge);
+};
+
+}
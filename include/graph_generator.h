@@ -0,0 +1,184 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <graph_edge_source.h>
+
+namespace graph
+{
+
+//
+// Reproducible synthetic graphs for scaling benchmarks.
+// Remark:
+// - A generator is an edge_source: every read_edges restarts the random
+//   engine (std::mt19937_64) from the seed and reports the same edges, so
+//   a generated graph can be streamed (compressed_graph, union-find, ...)
+//   without ever being stored. build creates a graph.
+// - Integers and doubles are derived from the raw engine output instead of
+//   the std distributions, whose results differ between standard
+//   libraries.
+// - Vertex ids are dense [0, vertex_count).
+// - Parameters out of range (e.g. more edges than vertex pairs) give an
+//   invalid generator: is_valid returns false and read_edges reports no
+//   edges.
+//
+class generator : public edge_source
+{
+public:
+	//
+	// Erdős–Rényi G(n, m): edge_count undirected edges between distinct,
+	// uniformly chosen vertex pairs (at most n(n-1)/2), weight uniform in
+	// [0, 1). No loops and no parallel edges.
+	//
+	static generator erdos_renyi(
+		const std::uint32_t vertex_count,
+		const std::uint64_t edge_count,
+		const std::uint64_t seed);
+
+	//
+	// R-MAT (recursive matrix, Kronecker-like) with 2^scale vertices:
+	// edge_count directed edges, every bit of source and target chosen from
+	// the quadrant probabilities a, b, c (d = 1 - a - b - c). Weight uniform
+	// in [0, 1). Loops and parallel edges are kept, as in Graph500.
+	//
+	static generator rmat(
+		const unsigned scale,
+		const std::uint64_t edge_count,
+		const std::uint64_t seed,
+		const double a = 0.57,
+		const double b = 0.19,
+		const double c = 0.19);
+
+	//
+	// 2D grid, vertex r * column_count + c is connected to its right and
+	// lower neighbor (undirected). Weight uniform in [0, 1).
+	//
+	static generator grid(
+		const std::uint32_t row_count,
+		const std::uint32_t column_count,
+		const std::uint64_t seed);
+
+	//
+	// Random geometric graph: uniform points in the unit square, an
+	// undirected edge for every pair closer than radius, the weight is the
+	// distance. The points are bucketed into a grid of cells, so only
+	// neighboring cells are compared.
+	//
+	static generator random_geometric(
+		const std::uint32_t vertex_count,
+		const double radius,
+		const std::uint64_t seed);
+
+	//
+	// Complete graph K_n of uniform points in the unit square, the weight is
+	// the Euclidean distance (like the K_* files).
+	//
+	static generator complete_euclidean(
+		const std::uint32_t vertex_count, const std::uint64_t seed);
+
+	//
+	// Bipartite graph for maximal_matching (like the Matching files): the
+	// sets [0, left_count) and [left_count, left_count + right_count),
+	// edge_count uniform directed edges from the left to the right set.
+	//
+	static generator bipartite(
+		const std::uint32_t left_count,
+		const std::uint32_t right_count,
+		const std::uint64_t edge_count,
+		const std::uint64_t seed);
+
+	//
+	// Minimum cost flow network (like the Kostenminimal files): integer
+	// balances in [-max_balance, max_balance] that cancel in pairs of
+	// neighboring vertex ids (an odd last vertex has 0), edge_count
+	// directed edges with integer cost and capacity in [1, 100]. A cycle
+	// through all vertices with enough capacity (and cost 1000) makes sure
+	// a b-flow exists, so there are edge_count + vertex_count edges.
+	// Like in the files there are no parallel or antiparallel edges, so
+	// edge_count is at most n(n-1)/2 - n.
+	//
+	static generator minimum_cost_flow(
+		const std::uint32_t vertex_count,
+		const std::uint64_t edge_count,
+		const std::uint32_t max_balance,
+		const std::uint64_t seed);
+
+	~generator();
+
+private:
+	enum class kind
+	{
+		erdos_renyi,
+		rmat,
+		grid,
+		random_geometric,
+		complete_euclidean,
+		bipartite,
+		minimum_cost_flow
+	};
+
+	generator(const kind, const std::uint32_t, const std::uint64_t, const std::uint64_t);
+
+	kind _kind;
+	std::uint32_t _vertex_count;
+	std::uint64_t _edge_count;
+	std::uint64_t _seed;
+
+	//
+	// False if a parameter of the factory was out of range.
+	//
+	bool _valid;
+
+	// Parameters of the single generators
+	unsigned _scale;
+	double _probabilities[3];
+	std::uint32_t _column_count;
+	std::uint32_t _left_count;
+	double _radius;
+
+	//
+	// Balance of every vertex of a minimum cost flow network.
+	//
+	std::vector<double> _balances;
+
+public:
+	std::uint32_t get_vertex_count(void) const override;
+
+	//
+	// Returns false (and reports no edges) for an invalid generator.
+	//
+	bool read_edges(const edge_consumer&) override;
+
+	//
+	// Returns false if a parameter of the factory was out of range.
+	//
+	bool is_valid(void) const;
+
+	//
+	// Returns true if the edges are directed (rmat, bipartite and
+	// minimum_cost_flow).
+	//
+	bool is_directed(void) const;
+
+	//
+	// Returns the balances of a minimum cost flow network, otherwise empty.
+	//
+	const std::vector<double>& get_balances(void) const;
+
+	//
+	// Add the vertices (with balances) and edges to a graph.
+	//
+	void build(graph& graph);
+
+private:
+	void read_erdos_renyi(std::mt19937_64&, const edge_consumer&) const;
+	void read_rmat(std::mt19937_64&, const edge_consumer&) const;
+	void read_grid(std::mt19937_64&, const edge_consumer&) const;
+	void read_random_geometric(std::mt19937_64&, const edge_consumer&) const;
+	void read_complete_euclidean(std::mt19937_64&, const edge_consumer&) const;
+	void read_bipartite(std::mt19937_64&, const edge_consumer&) const;
+	void read_minimum_cost_flow(std::mt19937_64&, const edge_consumer&) const;
+};
+
+}
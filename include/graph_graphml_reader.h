@@ -0,0 +1,136 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <graph.h>
+#include <graph_xml_parser.h>
+
+namespace graph
+{
+
+//
+// Streaming GraphML reader, collects the vertices and edges of a document
+// for the bulk build of a graph.
+// Remark:
+// - Values are taken from <data> elements whose <key> has the attr.name
+//   weight, cost, capacity (edges) or balance (nodes).
+// - yEd stores the values in the label text instead (the files in graph/):
+//   a node label "id" or "id/balance" and an edge label "weight" or
+//   "capacity/cost". Labels are used for values without <data>.
+// - If every node has a unique numeric label, the label is the vertex id.
+//   Otherwise the vertices are numbered in the order of appearance.
+// - Only the node ids and the edge records are kept, not the document.
+//
+class graphml_reader : private xml_handler
+{
+public:
+	graphml_reader();
+	~graphml_reader();
+
+private:
+	enum class attribute
+	{
+		none,
+		weight,
+		cost,
+		capacity,
+		balance
+	};
+
+	//
+	// Element whose text is collected.
+	//
+	enum class text_target
+	{
+		none,
+		data,
+		node_label,
+		edge_label
+	};
+
+	struct key
+	{
+		std::string id;
+		attribute value;
+	};
+
+	std::vector<key> _keys;
+
+	//
+	// Index of every GraphML node id, in the order of appearance.
+	//
+	std::unordered_map<std::string, std::uint32_t> _node_indices;
+
+	//
+	// Label id (invalid_id if none) and balance (NaN) of every node index.
+	//
+	std::vector<std::uint32_t> _label_ids;
+	std::vector<double> _balances;
+
+	//
+	// Edges with node indices as source/target.
+	//
+	std::vector<graph::edge_record> _records;
+
+	// State of the current element
+	std::size_t _depth;
+	bool _valid;
+
+	//
+	// Open nodes (yEd group nodes nest a graph) and the open edge.
+	//
+	std::vector<std::uint32_t> _nodes;
+	bool _edge;
+	graph::edge_record _record;
+
+	//
+	// Buffer for the lookup of a node id.
+	//
+	std::string _node_id;
+
+	text_target _text_target;
+	std::size_t _text_depth;
+	attribute _data_attribute;
+	std::string _text;
+
+public:
+	//
+	// Marks a node without numeric label.
+	//
+	static const std::uint32_t invalid_id =
+		std::numeric_limits<std::uint32_t>::max();
+
+	//
+	// Parse a GraphML document.
+	// Returns false if the document is malformed.
+	//
+	bool read(const char* begin, const char* end);
+
+	//
+	// Add the vertices and edges read so far to a graph.
+	//
+	void build(graph& graph, const bool create_directed_graph) const;
+
+private:
+	void start_element(
+		const std::string_view& name,
+		const std::vector<xml_attribute>& attributes) override;
+	void end_element(const std::string_view& name) override;
+	void characters(const std::string_view& text) override;
+
+	//
+	// Returns the index of a node id, new ids are appended.
+	//
+	std::uint32_t get_node_index(const std::string_view& id);
+
+	//
+	// Start collecting the text of the current element.
+	//
+	void collect_text(const text_target target);
+};
+
+}
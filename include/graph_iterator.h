@@ -4,12 +4,42 @@
 #include <vector>
 #include <memory>
 #include <cassert>
+#include <cstdint>
 
 namespace graph
 {
 class vertex;
 class edge;
 
+//------------------------------------------------------------------------------
+
+//
+// Converts a stored vertex/edge pointer to the requested type.
+// Remark:
+// - The stored type itself is returned without any runtime check.
+// - Derived types (vertex_with_balance, edge_with_cost_capacity) are
+//   checked with dynamic_cast.
+//
+template<typename T, typename B>
+struct element_cast
+{
+	static const T* apply(const B* element)
+	{
+		const T* result = dynamic_cast<const T*>(element);
+		assert(result);
+		return result;
+	}
+};
+
+template<typename B>
+struct element_cast<B, B>
+{
+	static const B* apply(const B* element)
+	{
+		return element;
+	}
+};
+
 //
 // http://anderberg.me/2016/07/04/c-custom-iterators/
 //
@@ -20,7 +50,20 @@ template<typename V>
 class vertex_iterator
 {
 private:
-	std::map<std::size_t, std::shared_ptr<vertex>>::const_iterator _iter;
+	//
+	// Vertices of a graph are stored in a dense table indexed by id (with
+	// empty slots) followed by a map with the sparse ids. The iterator walks
+	// the table first and skips the empty slots.
+	//
+	std::vector<vertex*>::const_iterator _dense;
+	std::vector<vertex*>::const_iterator _dense_end;
+	std::map<std::uint32_t, vertex*>::const_iterator _sparse;
+
+	void skip_empty_slots()
+	{
+		while(_dense != _dense_end && *_dense == nullptr)
+			++_dense;
+	}
 
 public:
 	// Iterator traits, previously from std::iterator.
@@ -33,31 +76,41 @@ public:
 	// Default constructible.
 	vertex_iterator() = default;
 	explicit vertex_iterator(
-		std::map<std::size_t, std::shared_ptr<vertex>>::const_iterator iter)
+		std::vector<vertex*>::const_iterator dense,
+		std::vector<vertex*>::const_iterator dense_end,
+		std::map<std::uint32_t, vertex*>::const_iterator sparse)
 		:
-		_iter(iter)
+		_dense(dense), _dense_end(dense_end), _sparse(sparse)
 	{
+		skip_empty_slots();
 	}
 
 	// Dereferencable.
 	pointer operator*() const
 	{
-		auto result = dynamic_cast<pointer>((*_iter).second.get());
-		assert(result);
-		return result;
+		const vertex* v = (_dense != _dense_end) ? *_dense : (*_sparse).second;
+		return element_cast<V, vertex>::apply(v);
 	}
 
 	// Pre- and post-incrementable.
 	vertex_iterator& operator++()
 	{
-		++_iter;
+		if(_dense != _dense_end)
+		{
+			++_dense;
+			skip_empty_slots();
+		}
+		else
+		{
+			++_sparse;
+		}
 		return *this;
 	}
 
 	vertex_iterator operator++(int)
 	{
 		vertex_iterator tmp = *this;
-		++_iter;
+		++(*this);
 		return tmp;
 	}
 
@@ -65,24 +118,28 @@ public:
 	bool operator==(const vertex_iterator& rhs)
 	{
 		// Equality: it == end().
-		return _iter == rhs._iter;
+		return _dense == rhs._dense && _sparse == rhs._sparse;
 	}
 
 	bool operator!=(const vertex_iterator& rhs)
 	{
 		// Inequality: it != end().
-		return _iter != rhs._iter;
+		return !(*this == rhs);
 	}
 };
 
 
 //------------------------------------------------------------------------------
 
-template<typename E>
+//
+// Iterates a list of edge pointers. The edges of a vertex are stored as
+// const edge*, the edges of a graph as edge*.
+//
+template<typename E, typename L = std::vector<const edge*>>
 class edge_iterator
 {
 private:
-	std::vector<const edge*>::const_iterator _iter;
+	typename L::const_iterator _iter;
 
 public:
 	// Iterator traits, previously from std::iterator.
@@ -94,7 +151,7 @@ public:
 
 	// Default constructible.
 	edge_iterator() = default;
-	explicit edge_iterator(std::vector<const edge*>::const_iterator iter)
+	explicit edge_iterator(typename L::const_iterator iter)
 		:
 		_iter(iter)
 	{
@@ -103,9 +160,7 @@ public:
 	// Dereferencable.
 	pointer operator*() const
 	{
-		auto result = dynamic_cast<pointer>(*_iter);
-		assert(result);
-		return result;
+		return element_cast<E, edge>::apply(*_iter);
 	}
 
 	// Pre- and post-incrementable.
@@ -138,67 +193,6 @@ public:
 
 //------------------------------------------------------------------------------
 
-template<typename E>
-class edge_iterator_on_multimap
-{
-private:
-	std::multimap<std::size_t, std::shared_ptr<edge>>::const_iterator _iter;
-
-public:
-	// Iterator traits, previously from std::iterator.
-	using value_type = const E;
-	using difference_type = std::ptrdiff_t;
-	using pointer = const E*;
-	using reference = const E&;
-	using iterator_category = std::input_iterator_tag;
-
-	// Default constructible.
-	edge_iterator_on_multimap() = default;
-	explicit edge_iterator_on_multimap(
-		std::multimap<std::size_t, std::shared_ptr<edge>>::const_iterator iter)
-		:
-		_iter(iter)
-	{
-	}
-
-	// Dereferencable.
-	pointer operator*() const
-	{
-		pointer result = dynamic_cast<pointer>((*_iter).second.get());
-		assert(result);
-		return result;
-	}
-
-	// Pre- and post-incrementable.
-	edge_iterator_on_multimap& operator++()
-	{
-		++_iter;
-		return *this;
-	}
-
-	edge_iterator_on_multimap operator++(int)
-	{
-		edge_iterator_on_multimap tmp = *this;
-		++_iter;
-		return tmp;
-	}
-
-	// Equality / inequality.
-	bool operator==(const edge_iterator_on_multimap& rhs)
-	{
-		// Equality: it == end().
-		return _iter == rhs._iter;
-	}
-
-	bool operator!=(const edge_iterator_on_multimap& rhs)
-	{
-		// Inequality: it != end().
-		return _iter != rhs._iter;
-	}
-};
-
-//------------------------------------------------------------------------------
-
 template<typename T>
 T begin(std::pair<T, T>& iter_pair)
 {
@@ -1,11 +1,18 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <graph_files.h>
 
 namespace graph
 {
 class graph;
+class csr_graph;
+class edge_source;
+class thread_pool;
+enum class edge_format;
 
 class loader
 {
@@ -20,7 +27,84 @@ public:
 		const bool create_directed_graph = false);
 	std::string file_name_get(const files& file);
 
+	//
+	// Open a file as a stream of edges instead of loading it into a graph
+	// (see edge_source).
+	//
+	std::unique_ptr<edge_source> open_edge_source(const files& file);
+
+	//
+	// Load a GraphML file, e.g. the yEd files in graph/ (see graphml_reader).
+	// yEd marks every graph as directed, so create_directed_graph decides
+	// like for the text files.
+	// Returns false if the file could not be read or is malformed.
+	//
+	bool load_graphml(
+		const std::string& file_name,
+		graph& graph,
+		const bool create_directed_graph = false);
+
+	//
+	// Load the standard benchmark formats from any path. Vertex ids are
+	// 0-based, so DIMACS/METIS vertex i becomes vertex i - 1.
+	// Returns false if the file could not be read or is malformed.
+	// Remark:
+	// - DIMACS shortest path (.gr): directed edges, the arc length is the
+	//   weight.
+	// - DIMACS maximum flow (.max): directed edges, the capacity is the
+	//   weight like in Fluss.txt (see algorithm::edmonds_karp).
+	// - DIMACS minimum cost flow (.min): balances (supply > 0), cost and
+	//   capacity like in Kostenminimal*.txt. Lower bounds must be 0.
+	// - METIS: undirected edges with the edge weights (if any), vertex
+	//   weights are skipped.
+	//
+	bool load_dimacs_shortest_path(const std::string& file_name, graph& graph);
+	bool load_dimacs_maximum_flow(
+		const std::string& file_name,
+		graph& graph,
+		std::uint32_t* source_id,
+		std::uint32_t* target_id);
+	bool load_dimacs_minimum_cost_flow(const std::string& file_name, graph& graph);
+	bool load_metis(const std::string& file_name, graph& graph);
+
+	//
+	// Write a graph into a binary snapshot file, which load_snapshot maps
+	// back as a read-only csr_graph without parsing.
+	// Returns false if a file could not be written/read.
+	//
+	bool save_snapshot(const std::string& file_name, const graph& graph);
+	bool load_snapshot(const std::string& file_name, csr_graph* graph);
+
+	//
+	// Number of threads that parse the edges of large files. The default 0
+	// uses one thread per hardware thread. The threads are started by the
+	// first large file and reused by the following loads.
+	//
+	void set_thread_count(const std::size_t);
+
+	//
+	// Parse with the threads of a pool (e.g. shared with an algorithm)
+	// instead of an own pool, nullptr returns to the own pool. The pool has
+	// to outlive the loads.
+	//
+	void set_thread_pool(thread_pool*);
+
 private:
+	std::size_t _thread_count;
+	thread_pool* _shared_pool;
+	std::unique_ptr<thread_pool> _own_pool;
+
+private:
+	//
+	// Returns the pool set by set_thread_pool or the own pool.
+	//
+	thread_pool* get_thread_pool(void);
+
+	//
+	// Returns the layout of a file.
+	//
+	edge_format get_edge_format(const files& file) const;
+
 	void load_adjacent_matrix(const std::string& file_name, graph& graph);
 
 	void load_edge_list(const std::string& file_name, graph& graph);
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace graph
+{
+
+//
+// Read-only view of a whole file.
+// Remark:
+// - On POSIX systems the file is memory mapped, so the data comes straight
+//   from the page cache. Otherwise the file is read into a buffer.
+// - A file that cannot be opened (or is empty) has the size 0.
+//
+class mapped_file
+{
+public:
+	mapped_file(const std::string& file_name);
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+	~mapped_file();
+
+private:
+	const char* _data;
+	std::size_t _size;
+	bool _open;
+
+	//
+	// Mapped memory, nullptr if the data is held by _buffer.
+	//
+	void* _mapping;
+	std::vector<char> _buffer;
+
+public:
+	//
+	// Returns true if the file was opened.
+	//
+	bool is_open(void) const;
+
+	//
+	// Returns the content of the file.
+	//
+	const char* get_data(void) const;
+	std::size_t get_size(void) const;
+};
+
+}
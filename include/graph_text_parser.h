@@ -0,0 +1,119 @@
+#pragma once
+#include <charconv>
+#include <cstdint>
+#include <string_view>
+
+namespace graph
+{
+
+//
+// Reads whitespace separated numbers from a character range.
+// Remark:
+// - Uses std::from_chars, independent of the locale and without streams.
+// - Blanks, tabs and line ends (\n and \r\n) separate the numbers.
+// - A read fails at the end of the range or on a malformed number, the
+//   number is not consumed then.
+//
+class text_parser
+{
+private:
+	const char* _position;
+	const char* _end;
+
+public:
+	text_parser(const char* begin, const char* end)
+		:
+		_position(begin),
+		_end(end)
+	{
+	}
+
+public:
+	//
+	// Read the next number.
+	//
+	bool read(std::uint32_t* value)
+	{
+		return read_number(value);
+	}
+
+	bool read(double* value)
+	{
+		return read_number(value);
+	}
+
+	//
+	// Read the next whitespace separated word (e.g. a line tag of a
+	// DIMACS file).
+	//
+	bool read(std::string_view* value)
+	{
+		skip_whitespace();
+
+		const char* begin = _position;
+
+		while(_position != _end && !is_whitespace(*_position))
+			++_position;
+
+		*value = std::string_view(begin, _position - begin);
+		return !value->empty();
+	}
+
+	//
+	// Move behind the next line end (e.g. behind a comment).
+	//
+	void skip_line(void)
+	{
+		while(_position != _end && *_position != '\n')
+			++_position;
+
+		if(_position != _end)
+			++_position;
+	}
+
+	//
+	// Returns true if only whitespace is left.
+	//
+	bool at_end(void)
+	{
+		skip_whitespace();
+		return _position == _end;
+	}
+
+	//
+	// Returns the current position in the range.
+	//
+	const char* get_position(void) const
+	{
+		return _position;
+	}
+
+private:
+	static bool is_whitespace(const char c)
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	}
+
+	void skip_whitespace(void)
+	{
+		while(_position != _end && is_whitespace(*_position))
+			++_position;
+	}
+
+	template<typename T>
+	bool read_number(T* value)
+	{
+		skip_whitespace();
+
+		const std::from_chars_result result =
+			std::from_chars(_position, _end, *value);
+
+		if(result.ec != std::errc())
+			return false;
+
+		_position = result.ptr;
+		return true;
+	}
+};
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace graph
+{
+
+//
+// Fixed set of worker threads for data parallel loops.
+// Remark:
+// - The thread that calls parallel_for works on the loop too, so a pool
+//   with thread_count 1 runs everything on the calling thread.
+// - The workers are started by the first loop with more than one index
+//   and wait for the following loops, so a pool should be kept and reused
+//   (see algorithm/loader set_thread_pool). A pool that only runs small
+//   loops never starts a thread.
+// - parallel_for must not be called from inside a loop body.
+// - A pool can be shared (e.g. by a loader and an algorithm used on
+//   different threads): concurrent parallel_for calls run one after the
+//   other.
+//
+class thread_pool
+{
+public:
+	//
+	// Create a pool, thread_count 0 uses one thread per hardware thread.
+	//
+	thread_pool(const std::size_t thread_count = 0);
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+	~thread_pool();
+
+private:
+	std::size_t _thread_count;
+	std::vector<std::thread> _workers;
+
+	//
+	// Held by the caller of parallel_for for the whole loop.
+	//
+	std::mutex _caller_mutex;
+
+	std::mutex _mutex;
+	std::condition_variable _start;
+	std::condition_variable _done;
+
+	//
+	// Current loop, valid while _running != 0.
+	//
+	const std::function<void(std::size_t)>* _body;
+	std::size_t _count;
+	std::atomic<std::size_t> _next;
+
+	//
+	// Number of workers that did not finish the current loop.
+	//
+	std::size_t _running;
+
+	//
+	// Incremented for every loop, so a worker runs every loop once.
+	//
+	std::uint64_t _generation;
+	bool _stop;
+
+public:
+	//
+	// Returns the number of threads that work on a loop (including the
+	// calling thread).
+	//
+	std::size_t get_thread_count(void) const;
+
+	//
+	// Returns the number of threads started so far (including the calling
+	// thread), 1 until the first large loop.
+	//
+	std::size_t get_started_thread_count(void) const;
+
+	//
+	// Call body(i) for every i in [0, count) and wait until all calls
+	// returned. The indices are handed out one by one, so the calls can run
+	// in any order on any thread.
+	//
+	void parallel_for(
+		const std::size_t count,
+		const std::function<void(std::size_t)>& body);
+
+private:
+	void run_worker(std::uint64_t generation);
+	void run_loop(void);
+};
+
+}
@@ -24,14 +24,14 @@ private:
 	std::vector<const edge*> _edges;
 
 	//
-	// Directed edges that points to this vertex.
+	// Edges that points to this vertex (the twin of an undirected edge too).
 	//
-	//std::vector<const edge*> _pointing_edges;
+	std::vector<const edge*> _pointing_edges;
 
 public:
 	vertex(const uint32_t);
 	vertex(const vertex&);
-	~vertex();
+	virtual ~vertex();
 
 public:
 	//
@@ -57,19 +57,33 @@ public:
 	void add_edge(const edge*);
 
 	//
-	// Add a directed edge that points to this vertex.
+	// Reserve space for the given number of additional edges.
 	//
-	//void add_pointing_edge(const edge*);
+	void reserve_edges(const std::size_t);
 
 	//
-	// Remove an edge from this vertex.
+	// Add an edge that points to this vertex.
+	//
+	void add_pointing_edge(const edge*);
+
+	//
+	// Reserve space for the given number of additional pointing edges.
+	//
+	void reserve_pointing_edges(const std::size_t);
+
+	//
+	// Remove an edge from this vertex in constant time.
+	// Remark:
+	// - The last edge takes the position of the removed edge.
 	//
 	void remove_edge(const edge* e);
 
 	//
-	// Remove a directed edge that points to this vertex.
+	// Remove an edge that points to this vertex in constant time.
+	// Remark:
+	// - The last edge takes the position of the removed edge.
 	//
-	//void remove_pointing_edge(const edge*);
+	void remove_pointing_edge(const edge*);
 
 	//
 	// Returns the begin/end iterator to the edges.
@@ -82,10 +96,21 @@ public:
 	}
 
 	//
-	// Returns the begin/end iterator to the directed edges that points to this
-	// vertex.
+	// Returns the begin/end iterator to the edges that points to this vertex.
+	//
+	template<typename E = edge>
+	std::pair<edge_iterator<E>, edge_iterator<E>> get_pointing_edges(void) const
+	{
+		return std::make_pair(
+			edge_iterator<E>(_pointing_edges.cbegin()),
+			edge_iterator<E>(_pointing_edges.cend()));
+	}
+
+	//
+	// Returns the number of outgoing/incoming edges.
 	//
-	//void get_pointing_edges(void) const;
+	std::size_t get_out_degree(void) const;
+	std::size_t get_in_degree(void) const;
 
 	std::shared_ptr<vertex> create_copy(void) const;
 
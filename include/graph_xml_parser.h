@@ -0,0 +1,89 @@
+#pragma once
+#include <string_view>
+#include <vector>
+
+namespace graph
+{
+
+struct xml_attribute
+{
+	std::string_view name;
+	std::string_view value;
+};
+
+//
+// Receives the events of xml_parser.
+// Remark:
+// - All views point into the parsed text and are only valid during the
+//   call. Entities (&amp; ...) are not decoded.
+// - Element and attribute names keep their namespace prefix (y:NodeLabel).
+//
+class xml_handler
+{
+public:
+	virtual ~xml_handler();
+
+	//
+	// An empty element (<a/>) is reported as start_element and end_element.
+	//
+	virtual void start_element(
+		const std::string_view& name,
+		const std::vector<xml_attribute>& attributes) = 0;
+	virtual void end_element(const std::string_view& name) = 0;
+
+	//
+	// Text between two tags (whitespace included), CDATA sections too.
+	//
+	virtual void characters(const std::string_view& text) = 0;
+
+	//
+	// Returns the value of an attribute or an empty view.
+	//
+	static std::string_view find_attribute(
+		const std::vector<xml_attribute>& attributes,
+		const std::string_view& name);
+
+	//
+	// Returns the name without namespace prefix.
+	//
+	static std::string_view local_name(const std::string_view& name);
+};
+
+//
+// Event based (SAX style) XML parser for a character range.
+// Remark:
+// - No document tree is built, the memory use does not depend on the size
+//   of the document.
+// - Declarations, processing instructions, comments and DOCTYPE are
+//   skipped. There is no validation beyond the tag structure.
+//
+class xml_parser
+{
+public:
+	xml_parser(const char* begin, const char* end);
+	~xml_parser();
+
+private:
+	const char* _position;
+	const char* _end;
+
+	//
+	// Reused for every start tag.
+	//
+	std::vector<xml_attribute> _attributes;
+
+public:
+	//
+	// Report the whole document to the handler.
+	// Returns false if the document is malformed.
+	//
+	bool parse(xml_handler* handler);
+
+private:
+	bool parse_tag(xml_handler* handler);
+	bool skip_until(const std::string_view& terminator);
+	void skip_whitespace(void);
+	std::string_view read_name(void);
+};
+
+}
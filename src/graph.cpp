@@ -1,6 +1,9 @@
 #include <graph.h>
 #include <vector>
+#include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <cmath>
 #include <graph_vertex.h>
 #include <graph_edge.h>
 #include <graph_comparer.h>
@@ -9,36 +12,87 @@
 namespace graph
 {
 
+graph::storage::storage()
+	:
+	vertex_count(0),
+	next_vertex_id(0)
+{
+}
+
 graph::graph()
 {
 }
 
 graph::graph(const graph& rhs)
 {
-	for(auto v : rhs.get_vertices())
+	copy_from(rhs.data);
+}
+
+graph::graph(graph&& rhs)
+	:
+	data(std::move(rhs.data))
+{
+	rhs.data = storage();
+}
+
+graph::~graph()
+{
+}
+
+graph& graph::operator=(const graph& rhs)
+{
+	if(this != &rhs)
 	{
-		const std::size_t hash_of_v = vertex::create_hash(v->get_id());
-		std::shared_ptr<vertex> copy_of_v = std::make_shared<vertex>(v->get_id());
+		data = storage();
+		copy_from(rhs.data);
+	}
+	return *this;
+}
+
+graph& graph::operator=(graph&& rhs)
+{
+	if(this != &rhs)
+	{
+		data = std::move(rhs.data);
+		rhs.data = storage();
+	}
+	return *this;
+}
+
+void graph::copy_from(const storage& rhs)
+{
+	// Copy of the edges whose twin is not copied yet.
+	std::unordered_map<const edge*, edge*> waiting_for_twin;
+
+	data.vertex_table.reserve(rhs.vertex_table.size());
+
+	for(const vertex* v : rhs.vertex_table)
+	{
+		if(v == nullptr)
+			continue;
+
+		vertex* copy_of_v = create_vertex(v->get_id());
 
 		if(v->has_balance())
 			copy_of_v->set_balance(v->get_balance());
-
-		vertices[hash_of_v] = copy_of_v;
 	}
-
-	// TODO: Twin handling
-	for(auto e : rhs.get_edges())
+	for(const auto& item : rhs.sparse_vertices)
 	{
-		std::shared_ptr<edge> copy_of_e = std::make_shared<edge>();
+		vertex* copy_of_v = create_vertex(item.first);
+
+		if(item.second->has_balance())
+			copy_of_v->set_balance(item.second->get_balance());
+	}
 
-		if(e->has_weight())
-			copy_of_e->set_weight(e->get_weight());
+	data.edge_arena.reserve(rhs.edges.size());
+	data.edges.reserve(rhs.edges.size());
+	data.edge_index.reserve(rhs.edge_index.size());
 
-		if(e->has_cost())
-			copy_of_e->set_cost(e->get_cost());
+	for(const edge* e : rhs.edges)
+	{
+		edge* copy_of_e = data.edge_arena.create();
 
-		if(e->has_capacity())
-			copy_of_e->set_capacity(e->get_capacity());
+		copy_of_e->assign_attributes(e);
 
 		vertex* v_source = get_vertex_internal(e->get_source()->get_id());
 		vertex* v_target = get_vertex_internal(e->get_target()->get_id());
@@ -46,86 +100,79 @@ graph::graph(const graph& rhs)
 		copy_of_e->set_source(v_source);
 		copy_of_e->set_target(v_target);
 
-		v_source->add_edge(copy_of_e.get());
+		if(e->has_twin())
+		{
+			const auto iter = waiting_for_twin.find(e->get_twin());
+
+			if(iter == waiting_for_twin.end())
+			{
+				waiting_for_twin.insert(std::make_pair(e, copy_of_e));
+			}
+			else
+			{
+				copy_of_e->set_twin(iter->second);
+				iter->second->set_twin(copy_of_e);
+				waiting_for_twin.erase(iter);
+			}
+		}
 
-		const std::size_t hash = copy_of_e->get_hash();
-		edges.insert(std::make_pair(hash, copy_of_e));
+		insert_edge(v_source, v_target, copy_of_e);
 	}
-}
 
-graph::~graph()
-{
+	assert(waiting_for_twin.empty());
 }
 
 const vertex* graph::add_vertex(const uint32_t id)
 {
-	const std::size_t hash = vertex::create_hash(id);
-	const bool vertex_not_found = vertices.count(hash) == 0;
+	vertex* v = get_vertex_internal(id);
 
-	if(vertex_not_found)
-	{
-		vertices[hash] = std::make_shared<vertex>(id);
-	}
+	if(v == nullptr)
+		v = create_vertex(id);
 
-	return vertices[hash].get();
+	return v;
 }
 
 const vertex* graph::add_vertex(const uint32_t id, const double balance)
 {
-	const std::size_t hash = vertex::create_hash(id);
-	const bool vertex_not_found = vertices.count(hash) == 0;
-	if(vertex_not_found)
+	vertex* v = get_vertex_internal(id);
+
+	if(v == nullptr)
 	{
-		auto v = std::make_shared<vertex>(id);
+		v = create_vertex(id);
 		v->set_balance(balance);
-
-		vertices[hash] = v;
 	}
-	return vertices[hash].get();
+
+	return v;
 }
 
 const vertex* graph::add_vertex(const uint32_t* id, const double* balance)
 {
-	std::shared_ptr<vertex> v;
+	// Without an id the vertex gets the next unused id.
+	const std::uint32_t new_id = (id == nullptr) ? data.next_vertex_id : *id;
 
-	if(id == nullptr)
-	{
-		std::uint32_t max_id = 0;
-		if(!vertices.empty())
-		{
-			for(auto item : vertices)
-				max_id = std::max(max_id, item.second->get_id());
-			++max_id;
-		}
-		v = std::make_shared<vertex>(max_id);
-	}
-	else
-	{
-		v = std::make_shared<vertex>(*id);
-	}
+	assert(get_vertex_internal(new_id) == nullptr);
+
+	vertex* v = create_vertex(new_id);
 
 	if(balance != nullptr)
 		v->set_balance(*balance);
 
-	const std::size_t hash = vertex::create_hash(v->get_id());
-	assert(vertices.count(hash) == 0);
-
-	vertices[hash] = v;
-
-	return v.get();
+	return v;
 }
 
 const vertex* graph::add_vertex(const vertex* v)
 {
-	std::shared_ptr<vertex> copy = v->create_copy();
-	const std::size_t hash = vertex::create_hash(*copy);
+	vertex* copy = get_vertex_internal(v->get_id());
 
-	if(vertices.count(hash) == 0)
+	if(copy == nullptr)
 	{
-		vertices[hash] = copy;
+		copy = create_vertex(v->get_id());
+
+		if(v->has_balance())
+			copy->set_balance(v->get_balance());
 	}
 
-	return vertices[hash].get();
+	return copy;
 }
 
 const vertex* graph::get_vertex(const std::uint32_t id) const
@@ -136,18 +183,58 @@ const vertex* graph::get_vertex(const std::uint32_t id) const
 
 vertex* graph::get_vertex_internal(const std::uint32_t id) const
 {
-	const std::size_t hash = vertex::create_hash(id);
-	const auto iter = vertices.find(hash);
+	if(id < data.vertex_table.size())
+		return data.vertex_table[id];
 
-	if(iter != vertices.end())
-		return (iter->second).get();
+	const auto iter = data.sparse_vertices.find(id);
+
+	if(iter != data.sparse_vertices.end())
+		return iter->second;
 	else
 		return nullptr;
 }
 
+vertex* graph::create_vertex(const std::uint32_t id)
+{
+	std::vector<vertex*>& table = data.vertex_table;
+	std::map<std::uint32_t, vertex*>& sparse = data.sparse_vertices;
+	vertex* v = data.vertex_arena.create(id);
+
+	// Grow the table as long as at least every second slot is used.
+	const std::size_t dense_limit =
+		std::max<std::size_t>(2 * data.vertex_count, 64) + table.size() / 2;
+
+	if(id < table.size())
+	{
+		table[id] = v;
+	}
+	else if(id < dense_limit)
+	{
+		table.resize(static_cast<std::size_t>(id) + 1, nullptr);
+		table[id] = v;
+
+		// Keep all sparse ids behind the table
+		while(!sparse.empty() && sparse.begin()->first < table.size())
+		{
+			table[sparse.begin()->first] = sparse.begin()->second;
+			sparse.erase(sparse.begin());
+		}
+	}
+	else
+	{
+		sparse[id] = v;
+	}
+
+	++data.vertex_count;
+	if(id >= data.next_vertex_id)
+		data.next_vertex_id = id + 1;
+
+	return v;
+}
+
 std::uint32_t graph::get_vertex_count(void) const
 {
-	return vertices.size();
+	return data.vertex_count;
 }
 
 //const std::vector<edge> graph::edge_get(const vertex& vertex) const
@@ -191,30 +278,26 @@ void graph::add_edge(const edge* new_edge)
 	vertex* source = get_vertex_internal(source_id);
 	vertex* target = get_vertex_internal(target_id);
 
-	std::shared_ptr<edge> forward_edge = new_edge->create_copy();
+	edge* forward_edge = data.edge_arena.create();
 
+	forward_edge->assign_attributes(new_edge);
 	forward_edge->set_source(source);
 	forward_edge->set_target(target);
 
-	source->add_edge(forward_edge.get());
-
-	const std::size_t forward_edge_hash = forward_edge->get_hash();
-	edges.insert(std::make_pair(forward_edge_hash, forward_edge));
+	insert_edge(source, target, forward_edge);
 
 	if(new_edge->has_twin())
 	{
-		std::shared_ptr<edge> backward_edge = new_edge->create_copy();
+		edge* backward_edge = data.edge_arena.create();
 
+		backward_edge->assign_attributes(new_edge);
 		backward_edge->set_source(target);
 		backward_edge->set_target(source);
 
-		target->add_edge(backward_edge.get());
-
-		forward_edge->set_twin(backward_edge.get());
-		backward_edge->set_twin(forward_edge.get());
+		forward_edge->set_twin(backward_edge);
+		backward_edge->set_twin(forward_edge);
 
-		const std::size_t backward_edge_hash = backward_edge->get_hash();
-		edges.insert(std::make_pair(backward_edge_hash, backward_edge));
+		insert_edge(target, source, backward_edge);
 	}
 }
 
@@ -255,8 +338,8 @@ void graph::add_undirected_edge(
 	vertex* source = get_vertex_internal(source_id);
 	vertex* target = get_vertex_internal(target_id);
 
-	std::shared_ptr<edge> src_edge = std::make_shared<edge>();
-	std::shared_ptr<edge> tgt_edge = std::make_shared<edge>();
+	edge* src_edge = data.edge_arena.create();
+	edge* tgt_edge = data.edge_arena.create();
 
 	src_edge->set_source(source);
 	tgt_edge->set_source(target);
@@ -264,8 +347,8 @@ void graph::add_undirected_edge(
 	src_edge->set_target(target);
 	tgt_edge->set_target(source);
 
-	src_edge->set_twin(tgt_edge.get());
-	tgt_edge->set_twin(src_edge.get());
+	src_edge->set_twin(tgt_edge);
+	tgt_edge->set_twin(src_edge);
 
 	if(weight != nullptr)
 	{
@@ -273,14 +356,8 @@ void graph::add_undirected_edge(
 		tgt_edge->set_weight(*weight);
 	}
 
-	source->add_edge(src_edge.get());
-	target->add_edge(tgt_edge.get());
-
-	const std::size_t hash_src_edge = src_edge->get_hash();
-	const std::size_t hash_tgt_edge = tgt_edge->get_hash();
-
-	edges.insert(std::make_pair(hash_src_edge, src_edge));
-	edges.insert(std::make_pair(hash_tgt_edge, tgt_edge));
+	insert_edge(source, target, src_edge);
+	insert_edge(target, source, tgt_edge);
 }
 
 void graph::add_directed_edge(
@@ -306,7 +383,7 @@ void graph::add_directed_edge(
 	vertex* source = get_vertex_internal(source_id);
 	vertex* target = get_vertex_internal(target_id);
 
-	std::shared_ptr<edge> src_tgt_edge = std::make_shared<edge>();
+	edge* src_tgt_edge = data.edge_arena.create();
 
 	src_tgt_edge->set_source(source);
 	src_tgt_edge->set_target(target);
@@ -316,11 +393,7 @@ void graph::add_directed_edge(
 		src_tgt_edge->set_weight(*weight);
 	}
 
-	source->add_edge(src_tgt_edge.get());
-
-	const std::size_t hash_src_edge = src_tgt_edge->get_hash();
-
-	edges.insert(std::make_pair(hash_src_edge, src_tgt_edge));
+	insert_edge(source, target, src_tgt_edge);
 }
 
 const edge* graph::add_directed_edge(
@@ -336,84 +409,147 @@ const edge* graph::add_directed_edge(
 	vertex* source = get_vertex_internal(source_id);
 	vertex* target = get_vertex_internal(target_id);
 
-	auto src_tgt_edge = std::make_shared<edge>();
+	edge* src_tgt_edge = data.edge_arena.create();
 
 	src_tgt_edge->set_source(source);
 	src_tgt_edge->set_target(target);
 	src_tgt_edge->set_cost(cost);
 	src_tgt_edge->set_capacity(capacity);
 
-	source->add_edge(src_tgt_edge.get());
+	insert_edge(source, target, src_tgt_edge);
+
+	return src_tgt_edge;
+}
+
+void graph::add_edges(
+	const std::vector<edge_record>& records,
+	const std::uint32_t vertex_count,
+	const bool create_directed_edges)
+{
+	const std::size_t new_edge_count =
+		records.size() * (create_directed_edges ? 1 : 2);
+
+	if(vertex_count > data.vertex_count)
+		data.vertex_arena.reserve(vertex_count - data.vertex_count);
+	if(vertex_count > data.vertex_table.size())
+		data.vertex_table.reserve(vertex_count);
+
+	for(std::uint32_t id = 0; id < vertex_count; ++id)
+	{
+		if(get_vertex_internal(id) == nullptr)
+			create_vertex(id);
+	}
+
+	// Vertices used by the edges, all vertices exist afterwards.
+	for(const edge_record& r : records)
+	{
+		if(get_vertex_internal(r.source_id) == nullptr)
+			create_vertex(r.source_id);
+		if(get_vertex_internal(r.target_id) == nullptr)
+			create_vertex(r.target_id);
+	}
+
+	// Size the adjacency lists of the dense vertices in one pass. Sparse
+	// vertices grow their lists as usual.
+	std::vector<std::uint32_t> out_degree(data.vertex_table.size(), 0);
+	std::vector<std::uint32_t> in_degree(data.vertex_table.size(), 0);
 
-	const std::size_t hash_src_edge = src_tgt_edge->get_hash();
+	for(const edge_record& r : records)
+	{
+		if(r.source_id < out_degree.size())
+			++out_degree[r.source_id];
+		if(r.target_id < in_degree.size())
+			++in_degree[r.target_id];
+	}
 
-	edges.insert(std::make_pair(hash_src_edge, src_tgt_edge));
+	for(std::size_t id = 0; id < out_degree.size(); ++id)
+	{
+		vertex* v = data.vertex_table[id];
 
-	return src_tgt_edge.get();
+		if(v == nullptr)
+			continue;
+
+		// The twin of an undirected edge adds the other direction.
+		if(create_directed_edges)
+		{
+			v->reserve_edges(out_degree[id]);
+			v->reserve_pointing_edges(in_degree[id]);
+		}
+		else
+		{
+			v->reserve_edges(out_degree[id] + in_degree[id]);
+			v->reserve_pointing_edges(out_degree[id] + in_degree[id]);
+		}
+	}
+
+	data.edge_arena.reserve(new_edge_count);
+	data.edges.reserve(data.edges.size() + new_edge_count);
+	data.edge_index.reserve(data.edge_index.size() + new_edge_count);
+
+	for(const edge_record& r : records)
+	{
+		vertex* source = get_vertex_internal(r.source_id);
+		vertex* target = get_vertex_internal(r.target_id);
+
+		edge* src_tgt_edge = data.edge_arena.create();
+
+		src_tgt_edge->set_source(source);
+		src_tgt_edge->set_target(target);
+
+		if(!std::isnan(r.weight))
+			src_tgt_edge->set_weight(r.weight);
+		if(!std::isnan(r.cost))
+			src_tgt_edge->set_cost(r.cost);
+		if(!std::isnan(r.capacity))
+			src_tgt_edge->set_capacity(r.capacity);
+
+		insert_edge(source, target, src_tgt_edge);
+
+		if(create_directed_edges)
+			continue;
+
+		edge* tgt_src_edge = data.edge_arena.create();
+
+		tgt_src_edge->assign_attributes(src_tgt_edge);
+		tgt_src_edge->set_source(target);
+		tgt_src_edge->set_target(source);
+
+		src_tgt_edge->set_twin(tgt_src_edge);
+		tgt_src_edge->set_twin(src_tgt_edge);
+
+		insert_edge(target, source, tgt_src_edge);
+	}
 }
 
-void graph::remove_edge(const edge& edge_remove)
+bool graph::remove_edge(const edge& edge_remove)
 {
-//	std::vector<edge> edge_vector;
-//	edge* edge_delete = nullptr;
+	const auto range = data.edge_index.equal_range(edge::create_key(
+		edge_remove.get_source()->get_id(), edge_remove.get_target()->get_id()));
+	const edge* found = nullptr;
 
-//	edge_vector.push_back(edge_remove);
-//	if(!edge_remove.directed())
-//	{
-//		edge_vector.push_back(edge_remove.reverse_direction());
-//	}
+	// Only the edge itself: an edge of another graph may have the same ids
+	// and position.
+	for(auto iter = range.first; iter != range.second; ++iter)
+	{
+		if(iter->second == &edge_remove)
+		{
+			found = iter->second;
+			break;
+		}
+	}
 
-//	for(const edge& edge : edge_vector)
-//	{
-//		const std::uint32_t source_id = edge.source_id();
-//		const std::uint32_t target_id = edge.target_id();
+	if(found == nullptr)
+		return false;
 
-//		// exist source_id?
-//		if(edges_map.count(source_id) != 0)
-//		{
-//			// exist target_id?
-//			if(edges_map[source_id].count(target_id) != 0)
-//			{
-//				// delete the first equal element of the vector
-//				for(std::size_t i = 0;
-//					i < ((edges_map[source_id])[target_id]).size();
-//					++i)
-//				{
-//					if(*((edges_map[source_id])[target_id])[i] != edge_remove)
-//						continue;
-
-//					edge_delete = ((edges_map[source_id])[target_id])[i];
-//					((edges_map[source_id])[target_id]).erase(
-//							((edges_map[source_id])[target_id]).begin() + i);
-//					break;
-//				}
-
-//				// if vector is empty, than remove the target_id from the map
-//				if(((edges_map[source_id])[target_id]).size() == 0)
-//				{
-//					(edges_map[source_id]).erase(target_id);
-//				}
-//			}
+	edge* e = data.edges[found->_position];
+	const edge* twin = e->get_twin();
 
-//			// if the target_id map is empty, than remove the source_id from the map
-//			if(edges_map[source_id].size() == 0)
-//			{
-//				edges_map.erase(source_id);
-//			}
-//		}
-//	}
+	destroy_edge(e);
 
-//	for(std::vector<edge*>::const_iterator i = edges.begin();
-//		i != edges.end();
-//		++i)
-//	{
-//		if( *i != edge_delete )
-//			continue;
+	if(twin != nullptr)
+		destroy_edge(data.edges[twin->_position]);
 
-//		delete *i;
-//		edges.erase(i);
-//		break;
-//	}
+	return true;
 }
 
 void graph::remove_edges(const vertex* source, const vertex* target)
@@ -421,60 +557,57 @@ void graph::remove_edges(const vertex* source, const vertex* target)
 	const std::uint32_t source_id = source->get_id();
 	const std::uint32_t target_id = target->get_id();
 
-	vertex* _source = get_vertex_internal(source_id);
-	vertex* _target = get_vertex_internal(target_id);
-
-	std::vector<size_t> hash_list;
-	std::vector<const edge*> source_list, target_list;
+	std::vector<edge*> edges_to_remove;
 
-	for(const edge* e : _source->get_edges())
+	for(const std::uint64_t key :
+		{ edge::create_key(source_id, target_id), edge::create_key(target_id, source_id) })
 	{
-		if(e->get_target()->get_id() != target_id)
-			continue;
-		source_list.push_back(e);
-		hash_list.push_back(e->get_hash());
-	}
-	for(const edge* e : source_list)
-		_source->remove_edge(e);
+		// A loop has the same key in both directions.
+		if(source_id == target_id && !edges_to_remove.empty())
+			break;
 
-	for(const edge* e : _target->get_edges())
-	{
-		if(e->get_target()->get_id() != source_id)
-			continue;
-		target_list.push_back(e);
-		hash_list.push_back(e->get_hash());
+		const auto range = data.edge_index.equal_range(key);
+
+		for(auto iter = range.first; iter != range.second; ++iter)
+			edges_to_remove.push_back(data.edges[iter->second->_position]);
 	}
-	for(const edge* e : target_list)
-		_target->remove_edge(e);
 
-	for(std::size_t hash : hash_list)
-		edges.erase(hash);
+	for(edge* e : edges_to_remove)
+		destroy_edge(e);
+}
+
+void graph::remove_vertex(const vertex* v)
+{
+	const std::uint32_t id = v->get_id();
+	vertex* _v = get_vertex_internal(id);
+
+	assert(_v != nullptr);
+
+	// remove_edge also removes the twin from the other list.
+	while(_v->get_out_degree() != 0)
+		remove_edge(**_v->get_edges().first);
+	while(_v->get_in_degree() != 0)
+		remove_edge(**_v->get_pointing_edges().first);
+
+	if(id < data.vertex_table.size())
+		data.vertex_table[id] = nullptr;
+	else
+		data.sparse_vertices.erase(id);
+
+	--data.vertex_count;
+	data.vertex_arena.destroy(_v);
 }
 
 std::uint32_t graph::get_edge_count(void) const
 {
-	return edges.size();
+	return data.edges.size();
 }
 
 const edge* graph::get_edge(
 	const vertex* source_vertex, const vertex* target_vertex) const
 {
-	const edge* result_edge = nullptr;
-	const vertex* search_vertex = get_vertex(source_vertex->get_id());
-
-	for(auto edge : search_vertex->get_edges())
-	{
-		// Edge should "point" in the right direction
-		assert(edge->get_source()->get_id() == search_vertex->get_id());
-
-		if(target_vertex->get_id() == edge->get_target()->get_id())
-		{
-			// More than one edge found.
-			assert(result_edge ==  nullptr);
-
-			result_edge = edge;
-		}
-	}
+	const edge* result_edge = find_edge(
+		edge::create_key(source_vertex->get_id(), target_vertex->get_id()));
 
 	// No edge found
 	assert(result_edge);
@@ -486,36 +619,86 @@ const edge* graph::get_edge(
 	const edge* foreign_edge,
 	const bool precise_match) const
 {
-	const edge* result_edge = nullptr;
-	directed_edge_equal deq;
-	undirected_edge_equal ueq;
+	const std::uint32_t source_id = foreign_edge->get_source()->get_id();
+	const std::uint32_t target_id = foreign_edge->get_target()->get_id();
+
+	const edge* result_edge = find_edge(edge::create_key(source_id, target_id));
 
-	for(const edge* graph_edge : get_edges())
+	if(!precise_match)
 	{
-		if(precise_match)
-		{
-			if(deq(foreign_edge, graph_edge))
-			{
-				assert(!result_edge);
-				result_edge = graph_edge;
-				//break;
-			}
-		}
-		else
-		{
-			if(ueq(foreign_edge, graph_edge))
-			{
-				assert(!result_edge);
-				result_edge = graph_edge;
-				//break;
-			}
-		}
+		const edge* flipped_edge = find_edge(edge::create_key(target_id, source_id));
+
+		// More than one edge found.
+		assert(!result_edge || !flipped_edge);
+
+		if(flipped_edge)
+			result_edge = flipped_edge;
 	}
 
 	assert(result_edge != nullptr);
 	return result_edge;
 }
 
+void graph::insert_edge(vertex* source, vertex* target, edge* new_edge)
+{
+	const std::uint32_t source_id = new_edge->get_source()->get_id();
+	const std::uint32_t target_id = new_edge->get_target()->get_id();
+
+	source->add_edge(new_edge);
+	target->add_pointing_edge(new_edge);
+
+	new_edge->_position = data.edges.size();
+	data.edges.push_back(new_edge);
+	data.edge_index.insert(std::make_pair(
+		edge::create_key(source_id, target_id), new_edge));
+}
+
+void graph::erase_edge(const edge* e)
+{
+	edge* last_edge = data.edges.back();
+
+	assert(data.edges[e->_position] == e);
+
+	last_edge->_position = e->_position;
+	data.edges[e->_position] = last_edge;
+	data.edges.pop_back();
+}
+
+void graph::destroy_edge(edge* e)
+{
+	const std::uint32_t source_id = e->get_source()->get_id();
+	const std::uint32_t target_id = e->get_target()->get_id();
+
+	get_vertex_internal(source_id)->remove_edge(e);
+	get_vertex_internal(target_id)->remove_pointing_edge(e);
+
+	const auto range =
+		data.edge_index.equal_range(edge::create_key(source_id, target_id));
+
+	for(auto iter = range.first; iter != range.second; ++iter)
+	{
+		if(iter->second != e)
+			continue;
+
+		data.edge_index.erase(iter);
+		break;
+	}
+
+	erase_edge(e);
+	data.edge_arena.destroy(e);
+}
+
+const edge* graph::find_edge(const std::uint64_t key) const
+{
+	const auto range = data.edge_index.equal_range(key);
+
+	if(range.first == range.second)
+		return nullptr;
+
+	// More than one edge found.
+	assert(std::next(range.first) == range.second);
 
+	return range.first->second;
+}
 
 }
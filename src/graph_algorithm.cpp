@@ -1,8 +1,10 @@
 #include <graph_algorithm.h>
 
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <queue>
+#include <random>
 #include <stack>
 #include <cassert>
 #include <chrono>
@@ -13,18 +15,29 @@
 #include <stdexcept>
 #include <sstream>
 #include <string>
+#include <limits>
 #include <list>
 #include <functional>
+#include <tuple>
 
 #include <graph_vertex.h>
 #include <graph.h>
+#include <graph_bit_matrix_graph.h>
+#include <graph_csr_graph.h>
 #include <graph_comparer.h>
+#include <graph_compressed_graph.h>
+#include <graph_disjoint_set.h>
 #include <graph_edge.h>
+#include <graph_edge_source.h>
+#include <graph_thread_pool.h>
 
 namespace graph
 {
 
 algorithm::algorithm()
+	:
+	_thread_count(0),
+	_shared_pool(nullptr)
 {
 }
 
@@ -32,6 +45,28 @@ algorithm::~algorithm()
 {
 }
 
+void algorithm::set_thread_count(const std::size_t thread_count)
+{
+	_thread_count = thread_count;
+	_own_pool.reset();
+}
+
+void algorithm::set_thread_pool(thread_pool* pool)
+{
+	_shared_pool = pool;
+}
+
+thread_pool* algorithm::get_thread_pool(void)
+{
+	if(_shared_pool != nullptr)
+		return _shared_pool;
+
+	if(!_own_pool)
+		_own_pool.reset(new thread_pool(_thread_count));
+
+	return _own_pool.get();
+}
+
 void algorithm::breadth_first_search(
 	const graph* graph_full,
 	const vertex* start_vertex,
@@ -64,37 +99,830 @@ void algorithm::breadth_first_search(
 			continue;
 		}
 	}
-	return;
+	return;
+}
+
+void algorithm::breadth_first_search(
+	const csr_graph* graph_full,
+	const std::uint32_t start_index,
+	std::vector<std::uint32_t>* predecessor)
+{
+	const std::uint32_t vertex_count = graph_full->get_vertex_count();
+	std::vector<std::uint32_t> processing_queue;
+	std::vector<bool> vertex_lookup(vertex_count, false);
+
+	predecessor->assign(vertex_count, csr_graph::invalid_index);
+
+	// The queue never holds more than vertex_count vertices, so a flat array
+	// with a read position replaces the deque.
+	processing_queue.reserve(vertex_count);
+	processing_queue.push_back(start_index);
+	vertex_lookup[start_index] = true;
+
+	for(std::size_t head = 0; head < processing_queue.size(); ++head)
+	{
+		const std::uint32_t index_current = processing_queue[head];
+		const std::uint32_t edge_end = graph_full->get_edge_end(index_current);
+
+		for(std::uint32_t e = graph_full->get_edge_begin(index_current); e < edge_end; ++e)
+		{
+			const std::uint32_t target_index = graph_full->get_target(e);
+
+			if(vertex_lookup[target_index])
+				continue;
+
+			processing_queue.push_back(target_index);
+			vertex_lookup[target_index] = true;
+			(*predecessor)[target_index] = index_current;
+		}
+	}
+}
+
+void algorithm::breadth_first_search(
+	const compressed_graph* graph_full,
+	const std::uint32_t start_index,
+	std::vector<std::uint32_t>* predecessor)
+{
+	const std::uint32_t vertex_count = graph_full->get_vertex_count();
+	std::vector<std::uint32_t> processing_queue;
+	std::vector<bool> vertex_lookup(vertex_count, false);
+
+	predecessor->assign(vertex_count, compressed_graph::invalid_index);
+
+	processing_queue.reserve(vertex_count);
+	processing_queue.push_back(start_index);
+	vertex_lookup[start_index] = true;
+
+	for(std::size_t head = 0; head < processing_queue.size(); ++head)
+	{
+		const std::uint32_t index_current = processing_queue[head];
+
+		for(const std::uint32_t target_index : graph_full->get_neighbors(index_current))
+		{
+			if(vertex_lookup[target_index])
+				continue;
+
+			processing_queue.push_back(target_index);
+			vertex_lookup[target_index] = true;
+			(*predecessor)[target_index] = index_current;
+		}
+	}
+}
+
+void algorithm::breadth_first_search(
+	const bit_matrix_graph* graph_full,
+	const std::uint32_t start_index,
+	std::vector<std::uint32_t>* predecessor)
+{
+	typedef bit_matrix_graph::word word;
+
+	const std::uint32_t vertex_count = graph_full->get_vertex_count();
+	const std::size_t word_count = graph_full->get_word_count();
+	std::vector<std::uint32_t> processing_queue;
+	std::vector<word> vertex_lookup(word_count, 0);
+
+	predecessor->assign(vertex_count, bit_matrix_graph::invalid_index);
+
+	processing_queue.reserve(vertex_count);
+	processing_queue.push_back(start_index);
+	vertex_lookup[start_index / bit_matrix_graph::word_bits] |=
+		word(1) << (start_index % bit_matrix_graph::word_bits);
+
+	for(std::size_t head = 0; head < processing_queue.size(); ++head)
+	{
+		const std::uint32_t index_current = processing_queue[head];
+		const word* row = graph_full->get_row(index_current);
+
+		for(std::size_t w = 0; w < word_count; ++w)
+		{
+			const word discovered = row[w] & ~vertex_lookup[w];
+
+			if(discovered == 0)
+				continue;
+
+			vertex_lookup[w] |= discovered;
+			bit_matrix_graph::for_each_bit(&discovered, 1,
+				[&](const std::uint32_t bit)
+				{
+					const std::uint32_t target_index =
+						static_cast<std::uint32_t>(w * bit_matrix_graph::word_bits + bit);
+
+					processing_queue.push_back(target_index);
+					(*predecessor)[target_index] = index_current;
+				});
+		}
+	}
+}
+
+namespace
+{
+
+//
+// Switch thresholds of the direction optimizing breadth first search
+// (Beamer et al.): go bottom-up when the frontier has more than 1/alpha of
+// the unexplored edges, back top-down when it has less than 1/beta of the
+// vertices.
+//
+const std::uint64_t direction_alpha = 15;
+const std::uint64_t direction_beta = 18;
+
+typedef std::uint64_t bfs_word;
+const std::uint32_t bfs_word_bits = 64;
+
+bool test_bit(const std::vector<bfs_word>& bits, const std::uint32_t index)
+{
+	return (bits[index / bfs_word_bits] >> (index % bfs_word_bits)) & 1;
+}
+
+void set_bit(std::vector<bfs_word>* bits, const std::uint32_t index)
+{
+	(*bits)[index / bfs_word_bits] |= bfs_word(1) << (index % bfs_word_bits);
+}
+
+//
+// Expand the frontier along its outgoing edges. Returns the number of
+// discovered vertices, edge_count is the sum of their out degrees.
+// predecessor_edge (optional) receives the discovering edges.
+//
+std::uint32_t bfs_top_down_step(
+	const csr_graph* graph_full,
+	const std::vector<std::uint32_t>& frontier,
+	std::vector<std::uint32_t>* next,
+	std::vector<bfs_word>* visited,
+	std::vector<std::uint32_t>* predecessor,
+	std::vector<std::uint32_t>* predecessor_edge,
+	std::uint64_t* edge_count)
+{
+	next->clear();
+
+	for(const std::uint32_t index_current : frontier)
+	{
+		const std::uint32_t edge_end = graph_full->get_edge_end(index_current);
+
+		for(std::uint32_t e = graph_full->get_edge_begin(index_current); e < edge_end; ++e)
+		{
+			const std::uint32_t target_index = graph_full->get_target(e);
+
+			if(test_bit(*visited, target_index))
+				continue;
+
+			set_bit(visited, target_index);
+			(*predecessor)[target_index] = index_current;
+			if(predecessor_edge != nullptr)
+				(*predecessor_edge)[target_index] = e;
+			next->push_back(target_index);
+			*edge_count += graph_full->get_degree(target_index);
+		}
+	}
+
+	return static_cast<std::uint32_t>(next->size());
+}
+
+//
+// Let every unvisited vertex search a frontier vertex among its incoming
+// edges. Returns the number of discovered vertices, edge_count is the sum
+// of their out degrees.
+// predecessor_edge (optional) receives the discovering edges, translated
+// by incoming_edge_index if it is not nullptr.
+//
+std::uint32_t bfs_bottom_up_step(
+	const csr_graph* graph_full,
+	const csr_graph* incoming,
+	const std::vector<bfs_word>& frontier,
+	std::vector<bfs_word>* next,
+	std::vector<bfs_word>* visited,
+	std::vector<std::uint32_t>* predecessor,
+	std::vector<std::uint32_t>* predecessor_edge,
+	const std::vector<std::uint32_t>* incoming_edge_index,
+	std::uint64_t* edge_count)
+{
+	const std::uint32_t vertex_count = graph_full->get_vertex_count();
+	std::uint32_t count = 0;
+
+	std::fill(next->begin(), next->end(), 0);
+
+	for(std::size_t w = 0; w < visited->size(); ++w)
+	{
+		for(bfs_word unvisited = ~(*visited)[w]; unvisited != 0; unvisited &= unvisited - 1)
+		{
+			const std::uint32_t index_current = static_cast<std::uint32_t>(
+				w * bfs_word_bits + bit_matrix_graph::count_trailing_zeros(unvisited));
+
+			if(index_current >= vertex_count)
+				break;
+
+			const std::uint32_t edge_end = incoming->get_edge_end(index_current);
+
+			for(std::uint32_t e = incoming->get_edge_begin(index_current); e < edge_end; ++e)
+			{
+				const std::uint32_t source_index = incoming->get_target(e);
+
+				if(!test_bit(frontier, source_index))
+					continue;
+
+				(*predecessor)[index_current] = source_index;
+				if(predecessor_edge != nullptr)
+				{
+					(*predecessor_edge)[index_current] =
+						incoming_edge_index != nullptr ? (*incoming_edge_index)[e] : e;
+				}
+				set_bit(next, index_current);
+				*edge_count += graph_full->get_degree(index_current);
+				++count;
+				break;
+			}
+		}
+	}
+
+	for(std::size_t w = 0; w < visited->size(); ++w)
+		(*visited)[w] |= (*next)[w];
+
+	return count;
+}
+
+}
+
+void algorithm::direction_optimizing_bfs(
+	const csr_graph* graph_full,
+	const csr_graph* incoming,
+	const std::uint32_t start_index,
+	std::vector<std::uint32_t>* predecessor,
+	std::vector<std::uint32_t>* predecessor_edge,
+	const std::vector<std::uint32_t>* incoming_edge_index)
+{
+	const std::uint32_t vertex_count = graph_full->get_vertex_count();
+	const std::size_t word_count = (vertex_count + bfs_word_bits - 1) / bfs_word_bits;
+	std::vector<bfs_word> visited(word_count, 0);
+	std::vector<bfs_word> frontier_bits(word_count, 0), next_bits(word_count, 0);
+	std::vector<std::uint32_t> frontier, next;
+
+	if(incoming == nullptr)
+	{
+		incoming = graph_full;
+		incoming_edge_index = nullptr;
+	}
+
+	assert(incoming->get_vertex_count() == vertex_count);
+
+	predecessor->assign(vertex_count, csr_graph::invalid_index);
+	if(predecessor_edge != nullptr)
+		predecessor_edge->assign(vertex_count, csr_graph::invalid_index);
+
+	frontier.reserve(vertex_count);
+	next.reserve(vertex_count);
+	frontier.push_back(start_index);
+	set_bit(&visited, start_index);
+
+	std::uint64_t frontier_edges = graph_full->get_degree(start_index);
+	std::uint64_t unexplored_edges = graph_full->get_edge_count() - frontier_edges;
+	std::uint32_t frontier_count = 1;
+	bool bottom_up = false;
+
+	while(frontier_count != 0)
+	{
+		if(!bottom_up && frontier_edges > unexplored_edges / direction_alpha)
+		{
+			std::fill(frontier_bits.begin(), frontier_bits.end(), 0);
+			for(const std::uint32_t index : frontier)
+				set_bit(&frontier_bits, index);
+			bottom_up = true;
+		}
+		else if(bottom_up && frontier_count < vertex_count / direction_beta)
+		{
+			frontier.clear();
+			bit_matrix_graph::for_each_bit(frontier_bits.data(), word_count,
+				[&frontier](const std::uint32_t index)
+				{
+					frontier.push_back(index);
+				});
+			bottom_up = false;
+		}
+
+		frontier_edges = 0;
+
+		if(bottom_up)
+		{
+			frontier_count = bfs_bottom_up_step(
+				graph_full, incoming, frontier_bits, &next_bits, &visited, predecessor,
+				predecessor_edge, incoming_edge_index, &frontier_edges);
+			frontier_bits.swap(next_bits);
+		}
+		else
+		{
+			frontier_count = bfs_top_down_step(
+				graph_full, frontier, &next, &visited, predecessor, predecessor_edge,
+				&frontier_edges);
+			frontier.swap(next);
+		}
+
+		unexplored_edges -= std::min(unexplored_edges, frontier_edges);
+	}
+}
+
+void algorithm::direction_optimizing_bfs(
+	const graph* graph_full,
+	const vertex* start_vertex,
+	graph* graph_sub)
+{
+	const csr_graph snapshot(graph_full);
+	csr_graph transpose;
+	std::vector<std::uint32_t> transpose_edge_index;
+	std::vector<std::uint32_t> predecessor, predecessor_edge;
+	std::vector<const edge*> snapshot_edges;
+	bool directed = false;
+
+	// The edges in the order of the snapshot edge indices.
+	snapshot_edges.reserve(snapshot.get_edge_count());
+	for(const vertex* v : graph_full->get_vertices())
+	{
+		for(const edge* e : v->get_edges())
+		{
+			snapshot_edges.push_back(e);
+			directed = directed || !e->has_twin();
+		}
+	}
+
+	if(directed)
+		snapshot.create_transpose(&transpose, &transpose_edge_index);
+
+	direction_optimizing_bfs(
+		&snapshot,
+		directed ? &transpose : nullptr,
+		snapshot.get_index(start_vertex->get_id()),
+		&predecessor,
+		&predecessor_edge,
+		directed ? &transpose_edge_index : nullptr);
+
+	for(std::uint32_t index = 0; index < snapshot.get_vertex_count(); ++index)
+	{
+		if(predecessor[index] == csr_graph::invalid_index)
+			continue;
+
+		const edge* e = snapshot_edges[predecessor_edge[index]];
+
+		// A bottom-up step without transpose finds the twin.
+		if(e->get_target()->get_id() != snapshot.get_id(index))
+			e = e->get_twin();
+
+		graph_sub->add_edge(e);
+	}
+}
+
+namespace
+{
+
+//
+// Vertices a thread expands at least per parallel step. Smaller levels are
+// expanded by the calling thread alone.
+//
+const std::size_t parallel_bfs_grain = 1024;
+
+//
+// Expand the levels of a breadth first search from start_index with the
+// threads of pool. parent[i] is claimed (set from invalid_index) by the
+// vertex that discovers i, the start vertex claims itself. level(frontier)
+// is called with the vertices of every level.
+//
+void parallel_bfs_levels(
+	const csr_graph* graph_full,
+	thread_pool* pool,
+	const std::uint32_t start_index,
+	std::vector<std::atomic<std::uint32_t>>* parent,
+	const std::function<void(const std::vector<std::uint32_t>&)>& level)
+{
+	std::vector<std::uint32_t> frontier, next;
+	std::vector<std::vector<std::uint32_t>> buffers;
+	std::vector<std::size_t> positions;
+
+	(*parent)[start_index].store(start_index, std::memory_order_relaxed);
+	frontier.push_back(start_index);
+
+	while(!frontier.empty())
+	{
+		level(frontier);
+
+		const std::size_t chunk_count = std::min(
+			(frontier.size() + parallel_bfs_grain - 1) / parallel_bfs_grain,
+			pool->get_thread_count() * 4);
+		const std::size_t chunk_size = (frontier.size() + chunk_count - 1) / chunk_count;
+
+		buffers.resize(std::max(buffers.size(), chunk_count));
+
+		const std::function<void(std::size_t)> expand =
+			[&](const std::size_t chunk)
+			{
+				std::vector<std::uint32_t>& buffer = buffers[chunk];
+				const std::size_t end = std::min(frontier.size(), (chunk + 1) * chunk_size);
+
+				buffer.clear();
+
+				for(std::size_t i = chunk * chunk_size; i < end; ++i)
+				{
+					const std::uint32_t index_current = frontier[i];
+					const std::uint32_t edge_end = graph_full->get_edge_end(index_current);
+
+					for(std::uint32_t e = graph_full->get_edge_begin(index_current); e < edge_end; ++e)
+					{
+						const std::uint32_t target_index = graph_full->get_target(e);
+						std::atomic<std::uint32_t>& target_parent = (*parent)[target_index];
+						std::uint32_t expected = csr_graph::invalid_index;
+
+						// Cheap check first, most targets are already claimed.
+						if(target_parent.load(std::memory_order_relaxed) != expected)
+							continue;
+
+						if(target_parent.compare_exchange_strong(
+							expected, index_current, std::memory_order_relaxed))
+						{
+							buffer.push_back(target_index);
+						}
+					}
+				}
+			};
+
+		if(chunk_count == 1)
+			expand(0);
+		else
+			pool->parallel_for(chunk_count, expand);
+
+		// Concatenate the buffers in chunk order to the next level.
+		positions.assign(chunk_count + 1, 0);
+		for(std::size_t chunk = 0; chunk < chunk_count; ++chunk)
+			positions[chunk + 1] = positions[chunk] + buffers[chunk].size();
+
+		next.resize(positions[chunk_count]);
+
+		const std::function<void(std::size_t)> gather =
+			[&](const std::size_t chunk)
+			{
+				std::copy(buffers[chunk].cbegin(), buffers[chunk].cend(),
+					next.begin() + positions[chunk]);
+			};
+
+		if(chunk_count == 1)
+			gather(0);
+		else
+			pool->parallel_for(chunk_count, gather);
+
+		frontier.swap(next);
+	}
+}
+
+}
+
+void algorithm::parallel_breadth_first_search(
+	const csr_graph* graph_full,
+	const std::uint32_t start_index,
+	std::vector<std::uint32_t>* predecessor)
+{
+	const std::uint32_t vertex_count = graph_full->get_vertex_count();
+	std::vector<std::atomic<std::uint32_t>> parent(vertex_count);
+	thread_pool* pool = get_thread_pool();
+
+	for(std::atomic<std::uint32_t>& p : parent)
+		p.store(csr_graph::invalid_index, std::memory_order_relaxed);
+
+	parallel_bfs_levels(graph_full, pool, start_index, &parent,
+		[](const std::vector<std::uint32_t>&) {});
+
+	predecessor->resize(vertex_count);
+
+	// Small graphs are copied by the calling thread alone.
+	pool->parallel_for((vertex_count + parallel_bfs_grain - 1) / parallel_bfs_grain,
+		[&](const std::size_t block)
+		{
+			const std::size_t begin = block * parallel_bfs_grain;
+			const std::size_t end = std::min<std::size_t>(vertex_count, begin + parallel_bfs_grain);
+
+			for(std::size_t i = begin; i < end; ++i)
+				(*predecessor)[i] = parent[i].load(std::memory_order_relaxed);
+		});
+
+	(*predecessor)[start_index] = csr_graph::invalid_index;
+}
+
+void algorithm::parallel_connected_component_with_bfs(
+	const csr_graph* graph_full,
+	std::vector<std::uint32_t>* component,
+	std::uint32_t* component_count)
+{
+	const std::uint32_t vertex_count = graph_full->get_vertex_count();
+	std::vector<std::atomic<std::uint32_t>> parent(vertex_count);
+	thread_pool* pool = get_thread_pool();
+
+	for(std::atomic<std::uint32_t>& p : parent)
+		p.store(csr_graph::invalid_index, std::memory_order_relaxed);
+
+	component->assign(vertex_count, csr_graph::invalid_index);
+	*component_count = 0;
+
+	for(std::uint32_t index = 0; index < vertex_count; ++index)
+	{
+		if(parent[index].load(std::memory_order_relaxed) != csr_graph::invalid_index)
+			continue;
+
+		const std::uint32_t number = (*component_count)++;
+
+		parallel_bfs_levels(graph_full, pool, index, &parent,
+			[component, number](const std::vector<std::uint32_t>& frontier)
+			{
+				for(const std::uint32_t i : frontier)
+					(*component)[i] = number;
+			});
+	}
+}
+
+namespace
+{
+
+//
+// Number of neighbors every vertex links before the largest component is
+// sampled, and the number of samples.
+//
+const std::uint32_t afforest_neighbor_rounds = 2;
+const std::uint32_t afforest_sample_count = 1024;
+
+//
+// Vertices per parallel step of the Afforest loops.
+//
+const std::size_t afforest_grain = 4096;
+
+//
+// Call body(begin, end) for blocks of [0, count) on the threads of a pool.
+// A single block runs on the calling thread.
+//
+void parallel_for_blocks(
+	thread_pool* pool,
+	const std::size_t count,
+	const std::function<void(std::uint32_t, std::uint32_t)>& body)
+{
+	const std::size_t block_count = (count + afforest_grain - 1) / afforest_grain;
+
+	pool->parallel_for(block_count,
+		[count, &body](const std::size_t block)
+		{
+			body(
+				static_cast<std::uint32_t>(block * afforest_grain),
+				static_cast<std::uint32_t>(std::min(count, (block + 1) * afforest_grain)));
+		});
+}
+
+//
+// Merge the trees of two vertices, the larger root is hooked below the
+// smaller one.
+//
+void afforest_link(
+	std::vector<std::atomic<std::uint32_t>>* parent,
+	const std::uint32_t u,
+	const std::uint32_t v)
+{
+	std::uint32_t p1 = (*parent)[u].load(std::memory_order_relaxed);
+	std::uint32_t p2 = (*parent)[v].load(std::memory_order_relaxed);
+
+	while(p1 != p2)
+	{
+		const std::uint32_t high = std::max(p1, p2);
+		const std::uint32_t low = std::min(p1, p2);
+		std::uint32_t p_high = (*parent)[high].load(std::memory_order_relaxed);
+
+		// Already hooked by another thread
+		if(p_high == low)
+			break;
+
+		if(p_high == high &&
+			(*parent)[high].compare_exchange_strong(p_high, low, std::memory_order_relaxed))
+		{
+			break;
+		}
+
+		// high is no root (anymore), continue with the parents
+		p1 = (*parent)[(*parent)[high].load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+		p2 = (*parent)[low].load(std::memory_order_relaxed);
+	}
+}
+
+//
+// Let every vertex point to its root.
+//
+void afforest_compress(
+	thread_pool* pool,
+	std::vector<std::atomic<std::uint32_t>>* parent)
+{
+	parallel_for_blocks(pool, parent->size(),
+		[parent](const std::uint32_t begin, const std::uint32_t end)
+		{
+			for(std::uint32_t i = begin; i < end; ++i)
+			{
+				std::uint32_t p = (*parent)[i].load(std::memory_order_relaxed);
+				std::uint32_t pp = (*parent)[p].load(std::memory_order_relaxed);
+
+				while(p != pp)
+				{
+					(*parent)[i].store(pp, std::memory_order_relaxed);
+					p = pp;
+					pp = (*parent)[p].load(std::memory_order_relaxed);
+				}
+			}
+		});
+}
+
+//
+// Returns the most frequent root of a sample of the vertices.
+//
+std::uint32_t afforest_sample_frequent_root(
+	const std::vector<std::atomic<std::uint32_t>>& parent)
+{
+	std::unordered_map<std::uint32_t, std::uint32_t> frequency;
+	std::mt19937 engine(0);
+	std::uint32_t result = 0, result_count = 0;
+
+	for(std::uint32_t i = 0; i < afforest_sample_count; ++i)
+	{
+		const std::uint32_t root = parent[engine() % parent.size()].load(std::memory_order_relaxed);
+		const std::uint32_t count = ++frequency[root];
+
+		if(count > result_count)
+		{
+			result = root;
+			result_count = count;
+		}
+	}
+
+	return result;
+}
+
+}
+
+void algorithm::connected_component_with_afforest(
+	const csr_graph* graph_full,
+	std::vector<std::uint32_t>* component,
+	std::uint32_t* component_count)
+{
+	const std::uint32_t vertex_count = graph_full->get_vertex_count();
+	std::vector<std::atomic<std::uint32_t>> parent(vertex_count);
+	thread_pool* pool = get_thread_pool();
+
+	component->assign(vertex_count, csr_graph::invalid_index);
+	*component_count = 0;
+
+	if(vertex_count == 0)
+		return;
+
+	parallel_for_blocks(pool, vertex_count,
+		[&parent](const std::uint32_t begin, const std::uint32_t end)
+		{
+			for(std::uint32_t i = begin; i < end; ++i)
+				parent[i].store(i, std::memory_order_relaxed);
+		});
+
+	// Link a few neighbors of every vertex, most vertices of a large
+	// component are in one tree afterwards.
+	for(std::uint32_t round = 0; round < afforest_neighbor_rounds; ++round)
+	{
+		parallel_for_blocks(pool, vertex_count,
+			[&, round](const std::uint32_t begin, const std::uint32_t end)
+			{
+				for(std::uint32_t i = begin; i < end; ++i)
+				{
+					const std::uint32_t e = graph_full->get_edge_begin(i) + round;
+
+					if(e < graph_full->get_edge_end(i))
+						afforest_link(&parent, i, graph_full->get_target(e));
+				}
+			});
+
+		afforest_compress(pool, &parent);
+	}
+
+	// The vertices of the largest component need no further edges, every
+	// other component is completed by the remaining edges. Undirected edges
+	// are stored in both directions, so an edge into the largest component
+	// is linked from the other side.
+	const std::uint32_t frequent_root = afforest_sample_frequent_root(parent);
+
+	parallel_for_blocks(pool, vertex_count,
+		[&](const std::uint32_t begin, const std::uint32_t end)
+		{
+			for(std::uint32_t i = begin; i < end; ++i)
+			{
+				if(parent[i].load(std::memory_order_relaxed) == frequent_root)
+					continue;
+
+				const std::uint32_t edge_end = graph_full->get_edge_end(i);
+
+				for(std::uint32_t e = graph_full->get_edge_begin(i) + afforest_neighbor_rounds;
+					e < edge_end; ++e)
+				{
+					afforest_link(&parent, i, graph_full->get_target(e));
+				}
+			}
+		});
+
+	afforest_compress(pool, &parent);
+
+	// Every root is the smallest index of its component, so numbering the
+	// roots in index order numbers the components by their smallest index.
+	for(std::uint32_t i = 0; i < vertex_count; ++i)
+	{
+		const std::uint32_t root = parent[i].load(std::memory_order_relaxed);
+
+		if(root == i)
+			(*component)[i] = (*component_count)++;
+		else
+			(*component)[i] = (*component)[root];
+	}
+}
+
+void algorithm::depth_first_search(
+	const graph* graph_full,
+	const vertex* vertex_start,
+	graph* graph_sub)
+{
+	typedef decltype(vertex_start->get_edges()) edge_range;
+
+	std::unordered_set<const vertex*> lookup;
+
+	// Remaining edges of every vertex on the current path
+	std::vector<edge_range> path;
+
+	lookup.insert(vertex_start);
+	path.push_back(vertex_start->get_edges());
+
+	while(!path.empty())
+	{
+		edge_range& edges = path.back();
+
+		if(edges.first == edges.second)
+		{
+			path.pop_back();
+			continue;
+		}
+
+		const edge* current_edge = *edges.first;
+		++edges.first;
+
+		const vertex* next_vertex = current_edge->get_target();
+		const bool next_vertex_found = !lookup.insert(next_vertex).second;
+
+		if(next_vertex_found)
+			continue;
+
+		graph_sub->add_edge(current_edge);
+		path.push_back(next_vertex->get_edges());
+	}
 }
 
 void algorithm::depth_first_search(
-	const graph* graph_full,
-	const vertex* vertex_start,
-	graph* graph_sub)
+	const csr_graph* graph_full,
+	const std::uint32_t start_index,
+	std::vector<std::uint32_t>* predecessor,
+	std::vector<std::uint32_t>* pre_order,
+	std::vector<std::uint32_t>* post_order)
 {
-	std::set<const vertex*, compare_vertex_id> lookup;
-
-	depth_first_search_recursive(graph_full, vertex_start, &lookup, graph_sub);
-}
+	const std::uint32_t vertex_count = graph_full->get_vertex_count();
+	std::vector<bool> vertex_lookup(vertex_count, false);
+	std::uint32_t time = 0;
+
+	// Vertex index and next edge index of every vertex on the current path
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> path;
+
+	predecessor->assign(vertex_count, csr_graph::invalid_index);
+	if(pre_order != nullptr)
+		pre_order->assign(vertex_count, csr_graph::invalid_index);
+	if(post_order != nullptr)
+		post_order->assign(vertex_count, csr_graph::invalid_index);
+
+	vertex_lookup[start_index] = true;
+	if(pre_order != nullptr)
+		(*pre_order)[start_index] = time;
+	++time;
+	path.push_back(std::make_pair(start_index, graph_full->get_edge_begin(start_index)));
+
+	while(!path.empty())
+	{
+		std::pair<std::uint32_t, std::uint32_t>& top = path.back();
+		const std::uint32_t index_current = top.first;
 
-void algorithm::depth_first_search_recursive(
-	const graph* graph_full,
-	const vertex* vertex_to_expand,
-	std::set<const vertex*, compare_vertex_id>* lookup,
-	graph* graph_sub )
-{
-	lookup->insert(vertex_to_expand);
+		if(top.second == graph_full->get_edge_end(index_current))
+		{
+			if(post_order != nullptr)
+				(*post_order)[index_current] = time;
+			++time;
+			path.pop_back();
+			continue;
+		}
 
-	for(auto current_edge : vertex_to_expand->get_edges())
-	{
-		const vertex* next_vertex = current_edge->get_target();
-		const bool next_vertex_found = lookup->count(next_vertex);
+		const std::uint32_t target_index = graph_full->get_target(top.second++);
 
-		if(next_vertex_found)
+		if(vertex_lookup[target_index])
 			continue;
 
-		graph_sub->add_edge(current_edge);
-		depth_first_search_recursive(graph_full, next_vertex, lookup, graph_sub);
+		vertex_lookup[target_index] = true;
+		(*predecessor)[target_index] = index_current;
+		if(pre_order != nullptr)
+			(*pre_order)[target_index] = time;
+		++time;
+		path.push_back(std::make_pair(target_index, graph_full->get_edge_begin(target_index)));
 	}
 }
 
@@ -105,11 +933,10 @@ void algorithm::connected_component_with_bfs(
 	connected_component(
 		graph_full,
 		subgraphs,
-		std::bind(&algorithm::breadth_first_search,
-			this,
-			std::placeholders::_1,
-			std::placeholders::_2,
-			std::placeholders::_3));
+		[this](const graph* g, const vertex* v, graph* sub)
+		{
+			breadth_first_search(g, v, sub);
+		});
 }
 
 void algorithm::connected_component_with_dfs(
@@ -119,11 +946,10 @@ void algorithm::connected_component_with_dfs(
 	connected_component(
 		graph_full,
 		subgraphs,
-		std::bind(&algorithm::depth_first_search,
-			this,
-			std::placeholders::_1,
-			std::placeholders::_2,
-			std::placeholders::_3));
+		[this](const graph* g, const vertex* v, graph* sub)
+		{
+			depth_first_search(g, v, sub);
+		});
 }
 
 void algorithm::connected_component(
@@ -131,11 +957,12 @@ void algorithm::connected_component(
 	std::vector<std::shared_ptr<graph>>* subgraphs,
 	const std::function<void(const graph*, const vertex*, graph*)>& search_algorithm )
 {
-	std::set<const vertex*, compare_vertex_id> lookup;
+	// The subgraphs hold copies of the vertices, so they are found by id.
+	std::unordered_set<std::uint32_t> lookup;
 
 	for(auto vertex_current : graph_full->get_vertices())
 	{
-		const bool vertex_found = lookup.count(vertex_current) != 0;
+		const bool vertex_found = lookup.count(vertex_current->get_id()) != 0;
 
 		if(vertex_found)
 			continue;
@@ -146,7 +973,7 @@ void algorithm::connected_component(
 
 		for(auto vertex_from_sub_graph : graph_sub->get_vertices())
 		{
-			lookup.insert(vertex_from_sub_graph);
+			lookup.insert(vertex_from_sub_graph->get_id());
 		}
 
 		subgraphs->push_back(graph_sub);
@@ -203,6 +1030,59 @@ void algorithm::prim(
 	}
 }
 
+//
+// Find the minimal spanning tree of a csr snapshot with the prim algorithm.
+//
+void algorithm::prim(
+	const csr_graph* full_graph,
+	const std::uint32_t start_index,
+	std::vector<std::uint32_t>* predecessor,
+	double* mst_cost)
+{
+	// (weight, target index, source index), smallest weight on top
+	typedef std::tuple<double, std::uint32_t, std::uint32_t> queue_entry;
+	std::priority_queue<
+		queue_entry, std::vector<queue_entry>, std::greater<queue_entry>> queue;
+	const std::uint32_t vertex_count = full_graph->get_vertex_count();
+	std::vector<bool> vertex_lookup(vertex_count, false);
+
+	assert(full_graph->has_weights());
+
+	predecessor->assign(vertex_count, csr_graph::invalid_index);
+	*mst_cost = 0.0;
+
+	queue.push(std::make_tuple(0.0, start_index, csr_graph::invalid_index));
+
+	while(!queue.empty())
+	{
+		const queue_entry entry = queue.top();
+		queue.pop();
+
+		const std::uint32_t add_index = std::get<1>(entry);
+
+		// Discard the edge, if both vertices processed.
+		if(vertex_lookup[add_index])
+			continue;
+
+		vertex_lookup[add_index] = true;
+		(*predecessor)[add_index] = std::get<2>(entry);
+		*mst_cost += std::get<0>(entry);
+
+		// Add all edges to the queue from the "unprocessed" vertex.
+		const std::uint32_t edge_end = full_graph->get_edge_end(add_index);
+		for(std::uint32_t e = full_graph->get_edge_begin(add_index); e < edge_end; ++e)
+		{
+			const std::uint32_t target_index = full_graph->get_target(e);
+
+			if(vertex_lookup[target_index])
+				continue;
+
+			queue.push(std::make_tuple(
+				full_graph->get_weight(e), target_index, add_index));
+		}
+	}
+}
+
 //
 // Find the minimal spanning tree with the kruskal algorithm.
 //
@@ -305,6 +1185,326 @@ void algorithm::kruskal(const graph* full_graph, graph* mst_graph, double* mst_c
 	assert(component_lookup.size() == 1);
 }
 
+bool algorithm::kruskal(edge_source* edges, graph* mst_graph, double* mst_cost)
+{
+	const std::uint32_t vertex_count = edges->get_vertex_count();
+	disjoint_set components(vertex_count);
+	std::vector<graph::edge_record> tree_edges;
+	double last_weight = -std::numeric_limits<double>::infinity();
+	bool sorted = true;
+	*mst_cost = 0.0;
+
+	const bool complete = edges->read_edges(
+		[&](const graph::edge_record& record)
+		{
+			// The input has to be sorted, there is no queue. Also stops
+			// at a missing (NaN) weight.
+			if(!(record.weight >= last_weight))
+			{
+				sorted = false;
+				return false;
+			}
+			last_weight = record.weight;
+
+			if(components.unite(record.source_id, record.target_id))
+			{
+				tree_edges.push_back(record);
+				*mst_cost += record.weight;
+			}
+
+			// Stop the stream as soon as the tree spans all vertices.
+			return components.get_set_count() > 1;
+		});
+
+	if(!sorted)
+	{
+		*mst_cost = 0.0;
+		return false;
+	}
+
+	mst_graph->add_edges(tree_edges, vertex_count, false);
+
+	return complete;
+}
+
+bool algorithm::compute_degree_statistics(
+	edge_source* edges, degree_statistics* statistics)
+{
+	*statistics = degree_statistics();
+	statistics->out_degrees.resize(edges->get_vertex_count(), 0);
+	statistics->in_degrees.resize(edges->get_vertex_count(), 0);
+
+	const bool complete = edges->read_edges(
+		[statistics](const graph::edge_record& record)
+		{
+			const std::uint32_t max_id = std::max(record.source_id, record.target_id);
+
+			if(max_id >= statistics->out_degrees.size())
+			{
+				statistics->out_degrees.resize(max_id + 1, 0);
+				statistics->in_degrees.resize(max_id + 1, 0);
+			}
+
+			++statistics->out_degrees[record.source_id];
+			++statistics->in_degrees[record.target_id];
+			++statistics->edge_count;
+
+			if(record.source_id == record.target_id)
+				++statistics->loop_count;
+
+			return true;
+		});
+
+	const std::size_t vertex_count = statistics->out_degrees.size();
+
+	if(vertex_count == 0)
+		return complete;
+
+	statistics->min_degree = std::numeric_limits<std::uint32_t>::max();
+
+	for(std::size_t id = 0; id < vertex_count; ++id)
+	{
+		const std::uint32_t degree =
+			statistics->out_degrees[id] + statistics->in_degrees[id];
+
+		statistics->min_degree = std::min(statistics->min_degree, degree);
+		statistics->max_degree = std::max(statistics->max_degree, degree);
+
+		if(degree == 0)
+			++statistics->isolated_vertex_count;
+	}
+
+	statistics->average_degree =
+		2.0 * static_cast<double>(statistics->edge_count) / vertex_count;
+
+	return complete;
+}
+
+bool algorithm::connected_component_with_union_find(
+	edge_source* edges, disjoint_set* components)
+{
+	*components = disjoint_set(edges->get_vertex_count());
+
+	return edges->read_edges(
+		[components](const graph::edge_record& record)
+		{
+			components->unite(record.source_id, record.target_id);
+			return true;
+		});
+}
+
+namespace
+{
+
+//
+// Returns the position of a vertex id in the ascending ids of a graph.
+//
+std::uint32_t get_dense_index(const std::vector<std::uint32_t>& ids, const std::uint32_t id)
+{
+	// Loaded graphs use the ids 0..n-1, so the id is mostly the index.
+	if(id < ids.size() && ids[id] == id)
+		return id;
+
+	return static_cast<std::uint32_t>(
+		std::lower_bound(ids.cbegin(), ids.cend(), id) - ids.cbegin());
+}
+
+std::vector<std::uint32_t> get_vertex_ids(const graph* g)
+{
+	std::vector<std::uint32_t> ids;
+
+	ids.reserve(g->get_vertex_count());
+	for(const vertex* v : g->get_vertices())
+		ids.push_back(v->get_id());
+
+	return ids;
+}
+
+}
+
+void algorithm::connected_component_with_union_find(
+	const graph* graph_full,
+	std::vector<std::uint32_t>* component,
+	std::vector<std::uint32_t>* component_sizes)
+{
+	const std::vector<std::uint32_t> ids = get_vertex_ids(graph_full);
+	const std::uint32_t vertex_count = static_cast<std::uint32_t>(ids.size());
+	disjoint_set components(vertex_count);
+
+	for(const edge* e : graph_full->get_edges())
+	{
+		components.unite(
+			get_dense_index(ids, e->get_source()->get_id()),
+			get_dense_index(ids, e->get_target()->get_id()));
+	}
+
+	// Number the representatives in the order of their smallest index.
+	std::vector<std::uint32_t> number(vertex_count, csr_graph::invalid_index);
+
+	component->resize(vertex_count);
+	component_sizes->clear();
+	component_sizes->reserve(components.get_set_count());
+
+	for(std::uint32_t index = 0; index < vertex_count; ++index)
+	{
+		std::uint32_t& representative_number = number[components.find(index)];
+
+		if(representative_number == csr_graph::invalid_index)
+		{
+			representative_number = static_cast<std::uint32_t>(component_sizes->size());
+			component_sizes->push_back(0);
+		}
+
+		(*component)[index] = representative_number;
+		++(*component_sizes)[representative_number];
+	}
+}
+
+void algorithm::create_component_subgraphs(
+	const graph* graph_full,
+	const std::vector<std::uint32_t>& component,
+	const std::uint32_t component_count,
+	std::vector<std::shared_ptr<graph>>* subgraphs)
+{
+	const std::vector<std::uint32_t> ids = get_vertex_ids(graph_full);
+	const std::size_t first = subgraphs->size();
+
+	assert(component.size() == ids.size());
+
+	for(std::uint32_t i = 0; i < component_count; ++i)
+		subgraphs->push_back(std::make_shared<graph>());
+
+	std::uint32_t index = 0;
+	for(const vertex* v : graph_full->get_vertices())
+		(*subgraphs)[first + component[index++]]->add_vertex(v);
+
+	for(const edge* e : graph_full->get_edges())
+	{
+		// add_edge copies the twin of an undirected edge as well.
+		if(e->has_twin())
+		{
+			const std::uint32_t source_id = e->get_source()->get_id();
+			const std::uint32_t target_id = e->get_target()->get_id();
+
+			if(source_id > target_id || (source_id == target_id && e > e->get_twin()))
+				continue;
+		}
+
+		const std::uint32_t number =
+			component[get_dense_index(ids, e->get_source()->get_id())];
+
+		(*subgraphs)[first + number]->add_edge(e);
+	}
+}
+
+void algorithm::connected_component_with_bfs(
+	const compressed_graph* full_graph,
+	std::vector<std::uint32_t>* component,
+	std::uint32_t* component_count)
+{
+	const std::uint32_t vertex_count = full_graph->get_vertex_count();
+	std::vector<std::uint32_t> processing_queue;
+
+	component->assign(vertex_count, compressed_graph::invalid_index);
+	processing_queue.reserve(vertex_count);
+	*component_count = 0;
+
+	for(std::uint32_t start_index = 0; start_index < vertex_count; ++start_index)
+	{
+		if((*component)[start_index] != compressed_graph::invalid_index)
+			continue;
+
+		// Every vertex enters the queue once, so it is reused for all
+		// components.
+		processing_queue.clear();
+		processing_queue.push_back(start_index);
+		(*component)[start_index] = *component_count;
+
+		for(std::size_t head = 0; head < processing_queue.size(); ++head)
+		{
+			for(const std::uint32_t target_index : full_graph->get_neighbors(processing_queue[head]))
+			{
+				if((*component)[target_index] != compressed_graph::invalid_index)
+					continue;
+
+				(*component)[target_index] = *component_count;
+				processing_queue.push_back(target_index);
+			}
+		}
+
+		++(*component_count);
+	}
+}
+
+void algorithm::connected_component_with_bfs(
+	const bit_matrix_graph* full_graph,
+	std::vector<std::uint32_t>* component,
+	std::uint32_t* component_count)
+{
+	typedef bit_matrix_graph::word word;
+
+	const std::uint32_t vertex_count = full_graph->get_vertex_count();
+	const std::size_t word_count = full_graph->get_word_count();
+	std::vector<std::uint32_t> processing_queue;
+	std::vector<word> vertex_lookup(word_count, 0);
+
+	component->assign(vertex_count, bit_matrix_graph::invalid_index);
+	processing_queue.reserve(vertex_count);
+	*component_count = 0;
+
+	// The start of the next component is the first bit that is not set in
+	// vertex_lookup, the words before start_word are full.
+	std::size_t start_word = 0;
+
+	while(true)
+	{
+		while(start_word < word_count && vertex_lookup[start_word] == ~word(0))
+			++start_word;
+
+		if(start_word == word_count)
+			break;
+
+		const std::uint32_t start_index = static_cast<std::uint32_t>(
+			start_word * bit_matrix_graph::word_bits +
+			bit_matrix_graph::count_trailing_zeros(~vertex_lookup[start_word]));
+
+		// Padding bits of the last word
+		if(start_index >= vertex_count)
+			break;
+
+		processing_queue.clear();
+		processing_queue.push_back(start_index);
+		vertex_lookup[start_word] |= word(1) << (start_index % bit_matrix_graph::word_bits);
+		(*component)[start_index] = *component_count;
+
+		for(std::size_t head = 0; head < processing_queue.size(); ++head)
+		{
+			const word* row = full_graph->get_row(processing_queue[head]);
+
+			for(std::size_t w = 0; w < word_count; ++w)
+			{
+				const word discovered = row[w] & ~vertex_lookup[w];
+
+				if(discovered == 0)
+					continue;
+
+				vertex_lookup[w] |= discovered;
+				bit_matrix_graph::for_each_bit(&discovered, 1,
+					[&](const std::uint32_t bit)
+					{
+						const std::uint32_t target_index =
+							static_cast<std::uint32_t>(w * bit_matrix_graph::word_bits + bit);
+
+						(*component)[target_index] = *component_count;
+						processing_queue.push_back(target_index);
+					});
+			}
+		}
+
+		++(*component_count);
+	}
+}
+
 void algorithm::nearest_neighbor(
 	const graph* full_graph, const vertex* start_vertex, graph* hamilton_graph)
 {
@@ -686,6 +1886,67 @@ void algorithm::dijkstra(
 	return;
 }
 
+//
+// Dijkstra-Algorithm on a csr snapshot
+//
+void algorithm::dijkstra(
+	const csr_graph* full_graph,
+	const std::uint32_t start_index,
+	std::vector<std::uint32_t>* predecessor,
+	std::vector<double>* distances,
+	bool* negative_weights_found)
+{
+	// (distance, vertex index), smallest distance on top
+	typedef std::pair<double, std::uint32_t> queue_entry;
+	std::priority_queue<
+		queue_entry, std::vector<queue_entry>, std::greater<queue_entry>> queue;
+	const std::uint32_t vertex_count = full_graph->get_vertex_count();
+	std::vector<bool> processed(vertex_count, false);
+
+	assert(full_graph->has_weights());
+
+	predecessor->assign(vertex_count, csr_graph::invalid_index);
+	distances->assign(vertex_count, std::numeric_limits<double>::infinity());
+	if(negative_weights_found)
+		*negative_weights_found = false;
+
+	(*distances)[start_index] = 0.0;
+	queue.push(std::make_pair(0.0, start_index));
+
+	while(!queue.empty())
+	{
+		const std::uint32_t current_index = queue.top().second;
+		queue.pop();
+
+		// Outdated queue entry of an already examined vertex
+		if(processed[current_index])
+			continue;
+		processed[current_index] = true;
+
+		const double current_distance = (*distances)[current_index];
+		const std::uint32_t edge_end = full_graph->get_edge_end(current_index);
+
+		for(std::uint32_t e = full_graph->get_edge_begin(current_index); e < edge_end; ++e)
+		{
+			const double weight = full_graph->get_weight(e);
+			const std::uint32_t target_index = full_graph->get_target(e);
+
+			if(weight < 0.0 && negative_weights_found)
+				*negative_weights_found = true;
+
+			const double new_distance = current_distance + weight;
+
+			// If the new route is better, update the data
+			if(new_distance < (*distances)[target_index])
+			{
+				(*distances)[target_index] = new_distance;
+				(*predecessor)[target_index] = current_index;
+				queue.push(std::make_pair(new_distance, target_index));
+			}
+		}
+	}
+}
+
 void algorithm::moore_bellman_ford(
 	const graph* g,
 	const vertex* start_vertex,
@@ -781,6 +2042,64 @@ void algorithm::moore_bellman_ford(
 	return;
 }
 
+void algorithm::moore_bellman_ford(
+	const csr_graph* g,
+	const std::uint32_t start_index,
+	std::vector<std::uint32_t>* predecessor,
+	std::vector<double>* distances,
+	bool* negative_cycle_found)
+{
+	const std::uint32_t vertex_count = g->get_vertex_count();
+	const bool use_cost = g->has_costs();
+
+	assert(use_cost || g->has_weights());
+
+	predecessor->assign(vertex_count, csr_graph::invalid_index);
+	distances->assign(vertex_count, std::numeric_limits<double>::infinity());
+	(*distances)[start_index] = 0.0;
+
+	bool negative_cycle = false;
+
+	// Compute the distances and the predecessor.
+	// The last round (i == vertex_count - 1) detects the negative cycle.
+	for(std::uint32_t i = 0; i < vertex_count; ++i)
+	{
+		bool distance_changed = false;
+
+		for(std::uint32_t source_index = 0; source_index < vertex_count; ++source_index)
+		{
+			const double source_distance = (*distances)[source_index];
+
+			if(source_distance == std::numeric_limits<double>::infinity())
+				continue;
+
+			const std::uint32_t edge_end = g->get_edge_end(source_index);
+			for(std::uint32_t e = g->get_edge_begin(source_index); e < edge_end; ++e)
+			{
+				const std::uint32_t target_index = g->get_target(e);
+				const double cost = use_cost ? g->get_cost(e) : g->get_weight(e);
+				const double new_distance = source_distance + cost;
+
+				if(new_distance < (*distances)[target_index])
+				{
+					(*distances)[target_index] = new_distance;
+					(*predecessor)[target_index] = source_index;
+					distance_changed = true;
+				}
+			}
+		}
+
+		// Nothing changed, the distances are final.
+		if(!distance_changed)
+			break;
+
+		negative_cycle = ((i + 1) == vertex_count);
+	}
+
+	if(negative_cycle_found)
+		*negative_cycle_found = negative_cycle;
+}
+
 void algorithm::edmonds_karp(
 	const graph* full_graph,
 	const vertex* source_vertex,
@@ -1085,24 +2404,24 @@ void algorithm::cc_compute_b_flow(
 	{
 		const double balance = v->get_balance();
 		const double cost = 0.0;
-		std::shared_ptr<edge> e = std::make_shared<edge>();
+		edge e;
 
 		if(balance > 0.0)
 		{
-			e->set_source(super_source);
-			e->set_target(v);
-			e->set_capacity(balance);
-			e->set_cost(cost);
+			e.set_source(super_source);
+			e.set_target(v);
+			e.set_capacity(balance);
+			e.set_cost(cost);
 		}
 		else // if(balance < 0.0)
 		{
-			e->set_source(v);
-			e->set_target(super_target);
-			e->set_capacity(balance * -1.0);
-			e->set_cost(cost);
+			e.set_source(v);
+			e.set_target(super_target);
+			e.set_capacity(balance * -1.0);
+			e.set_cost(cost);
 		}
 
-		b_flow_graph.add_edge(e.get());
+		b_flow_graph.add_edge(&e);
 	}
 
 	std::unordered_map<
@@ -1199,28 +2518,30 @@ void algorithm::add_residual_edge(
 
 	if(uf_forward_edge > 0.0)
 	{
-		std::shared_ptr<edge> forward_edge = original_edge->create_copy();
+		edge forward_edge;
 
-		forward_edge->set_capacity(uf_forward_edge);
-		forward_edge->set_cost(edge_cost);
-		forward_edge->set_source(residual_graph->get_vertex(source_id));
-		forward_edge->set_target(residual_graph->get_vertex(target_id));
+		forward_edge.assign_attributes(original_edge);
+		forward_edge.set_capacity(uf_forward_edge);
+		forward_edge.set_cost(edge_cost);
+		forward_edge.set_source(residual_graph->get_vertex(source_id));
+		forward_edge.set_target(residual_graph->get_vertex(target_id));
 
-		// Insert forward edge
-		residual_graph->add_edge(forward_edge.get());
+		// Insert forward edge (residual_graph stores a copy in its arena)
+		residual_graph->add_edge(&forward_edge);
 	}
 
 	if(uf_backward_edge > 0.0)
 	{
-		std::shared_ptr<edge> backward_edge = original_edge->create_copy();
+		edge backward_edge;
 
-		backward_edge->set_capacity(uf_backward_edge);
-		backward_edge->set_cost(-edge_cost);
-		backward_edge->set_source(residual_graph->get_vertex(target_id));
-		backward_edge->set_target(residual_graph->get_vertex(source_id));
+		backward_edge.assign_attributes(original_edge);
+		backward_edge.set_capacity(uf_backward_edge);
+		backward_edge.set_cost(-edge_cost);
+		backward_edge.set_source(residual_graph->get_vertex(target_id));
+		backward_edge.set_target(residual_graph->get_vertex(source_id));
 
-		// Insert backward edge
-		residual_graph->add_edge(backward_edge.get());
+		// Insert backward edge (residual_graph stores a copy in its arena)
+		residual_graph->add_edge(&backward_edge);
 	}
 }
 
@@ -1234,49 +2555,30 @@ void algorithm::cc_find_negative_cycle(
 	std::list<const edge*>* cycle,
 	double* gamma)
 {
-	graph search_graph(*residual_graph);
-
-	// Create a start_vertex and connect all other vertices with the start_vertex
-	const vertex* start_vertex = search_graph.add_vertex(nullptr, nullptr);
-	for(const vertex* v : search_graph.get_vertices())
-	{
-		if(v->get_id() == start_vertex->get_id())
-			continue;
-
-		edge e;
-		e.set_source(start_vertex);
-		e.set_target(v);
-		e.set_cost(0.0);
-		search_graph.add_edge(&e);
-	}
-
-	// Edge from the predecessor vertex. (target == vertex)
-	std::map<const vertex*, double> distances;
-	std::map<const vertex*, const edge*> predecessor;
+	// Bellman-Ford from a virtual start vertex that is connected with all
+	// other vertices by edges with cost 0. The virtual vertex is not added
+	// to a copy of the residual_graph, instead every vertex starts with the
+	// distance 0 and without predecessor.
+	std::unordered_map<const vertex*, double> distances;
+	std::unordered_map<const vertex*, const edge*> predecessor;
 
 	// Initialize distances and predecessor
-	for(const vertex* v : search_graph.get_vertices())
+	for(const vertex* v : residual_graph->get_vertices())
 	{
-		double initial_distance = std::numeric_limits<double>::infinity();
-
-		if(v->get_id() == start_vertex->get_id())
-		{
-			initial_distance = 0.0;
-		}
-
-		distances.insert(std::make_pair(v, initial_distance));
+		distances.insert(std::make_pair(v, 0.0));
 		predecessor.insert(std::make_pair(v, nullptr));
 	}
 
 	// Compute the distances and the predecessor
-	const std::uint32_t vertex_count = search_graph.get_vertex_count();
+	// (+1 for the virtual start vertex)
+	const std::uint32_t vertex_count = residual_graph->get_vertex_count() + 1;
 	std::list<const vertex*> changed_set;
 
 	for(std::uint32_t i = 0; i < vertex_count; ++i)
 	{
 		const bool is_last_round = ((i + 1) == vertex_count);
 
-		for(auto edge : search_graph.get_edges())
+		for(auto edge : residual_graph->get_edges())
 		{
 			const vertex* source_vertex = edge->get_source();
 			const vertex* target_vertex = edge->get_target();
@@ -1325,7 +2627,7 @@ void algorithm::cc_find_negative_cycle(
 			const edge* e = predecessor[v];
 			v = e->get_source();
 
-			cycle->push_back(residual_graph->get_edge(e));
+			cycle->push_back(e);
 			*gamma = std::min(*gamma, e->get_capacity());
 		}
 	}
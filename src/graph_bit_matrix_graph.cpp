@@ -0,0 +1,108 @@
+#include <graph_bit_matrix_graph.h>
+
+#include <graph.h>
+#include <graph_edge_source.h>
+
+namespace graph
+{
+
+const std::size_t bit_matrix_graph::word_bits;
+const std::uint32_t bit_matrix_graph::invalid_index;
+
+bit_matrix_graph::bit_matrix_graph()
+	:
+	_vertex_count(0),
+	_word_count(0),
+	_valid(true)
+{
+}
+
+bit_matrix_graph::bit_matrix_graph(const std::uint32_t vertex_count)
+	:
+	_vertex_count(vertex_count),
+	_word_count((vertex_count + word_bits - 1) / word_bits),
+	_bits(vertex_count * _word_count, 0),
+	_valid(true)
+{
+}
+
+bit_matrix_graph::bit_matrix_graph(
+	edge_source* edges,
+	const bool create_directed_graph)
+	:
+	bit_matrix_graph(edges->get_vertex_count())
+{
+	bool in_range = true;
+
+	_valid = edges->read_edges(
+		[this, create_directed_graph, &in_range](const graph::edge_record& record)
+		{
+			if(record.source_id >= _vertex_count || record.target_id >= _vertex_count)
+			{
+				in_range = false;
+				return false;
+			}
+
+			set_edge(record.source_id, record.target_id);
+			if(!create_directed_graph)
+				set_edge(record.target_id, record.source_id);
+			return true;
+		}) && in_range;
+
+	if(!_valid)
+	{
+		_vertex_count = 0;
+		_word_count = 0;
+		std::vector<word>().swap(_bits);
+	}
+}
+
+bit_matrix_graph::~bit_matrix_graph()
+{
+}
+
+bool bit_matrix_graph::is_valid(void) const
+{
+	return _valid;
+}
+
+std::uint32_t bit_matrix_graph::get_vertex_count(void) const
+{
+	return _vertex_count;
+}
+
+std::uint64_t bit_matrix_graph::get_edge_count(void) const
+{
+	std::uint64_t count = 0;
+
+	for(const word w : _bits)
+		count += popcount(w);
+
+	return count;
+}
+
+std::uint32_t bit_matrix_graph::get_degree(const std::uint32_t index) const
+{
+	const word* row = get_row(index);
+	std::uint32_t degree = 0;
+
+	for(std::size_t w = 0; w < _word_count; ++w)
+		degree += popcount(row[w]);
+
+	return degree;
+}
+
+std::uint32_t bit_matrix_graph::get_common_neighbor_count(
+	const std::uint32_t lhs, const std::uint32_t rhs) const
+{
+	const word* lhs_row = get_row(lhs);
+	const word* rhs_row = get_row(rhs);
+	std::uint32_t count = 0;
+
+	for(std::size_t w = 0; w < _word_count; ++w)
+		count += popcount(lhs_row[w] & rhs_row[w]);
+
+	return count;
+}
+
+}
@@ -0,0 +1,68 @@
+#include <graph_buffered_writer.h>
+
+#include <cstring>
+
+namespace graph
+{
+
+const std::size_t buffered_writer::buffer_size;
+const std::size_t buffered_writer::max_number_length;
+
+buffered_writer::buffered_writer(const std::string& file_name)
+	:
+	_stream(file_name.c_str(), std::ios::binary | std::ios::trunc),
+	_buffer(buffer_size),
+	_size(0)
+{
+}
+
+buffered_writer::~buffered_writer()
+{
+	close();
+}
+
+bool buffered_writer::is_open(void) const
+{
+	return _stream.is_open();
+}
+
+bool buffered_writer::close(void)
+{
+	if(!_stream.is_open())
+		return false;
+
+	flush();
+	_stream.close();
+
+	return !_stream.fail();
+}
+
+void buffered_writer::write_bytes(const void* data, const std::size_t size)
+{
+	const char* bytes = static_cast<const char*>(data);
+
+	if(_buffer.size() - _size < size)
+	{
+		flush();
+
+		// Large blocks go to the file directly.
+		if(size >= _buffer.size())
+		{
+			_stream.write(bytes, size);
+			return;
+		}
+	}
+
+	std::memcpy(_buffer.data() + _size, bytes, size);
+	_size += size;
+}
+
+void buffered_writer::flush(void)
+{
+	if(_size != 0)
+		_stream.write(_buffer.data(), _size);
+
+	_size = 0;
+}
+
+}
@@ -1,7 +1,6 @@
 #include <graph_comparer.h>
 #include <functional>
-#include <sstream>
-#include <string>
+#include <cstdint>
 #include <graph_vertex.h>
 #include <graph_edge.h>
 
@@ -43,41 +42,19 @@ bool compare_edge_weight::operator()(const edge& lhs, const edge& rhs) const
 
 std::size_t undirected_edge_hash::operator()(const edge* edge) const
 {
-	const std::uint32_t source_id = edge->get_source()->get_id();
-	const std::uint32_t target_id = edge->get_target()->get_id();
-
-	std::stringstream ss;
-	std::hash<std::string> h;
-
-	if(source_id < target_id)
-	{
-		ss << source_id << "-" << target_id;
-	}
-	else
-	{
-		ss << target_id << "-" << source_id;
-	}
-
-	const std::size_t hash = h(ss.str());
-
-	return hash;
+	return edge::create_hash(edge);
 }
 
 //------------------------------------------------------------------------------
 
 std::size_t directed_edge_hash::operator()(const edge* edge) const
 {
-	const std::uint32_t source_id = edge->get_source()->get_id();
-	const std::uint32_t target_id = edge->get_target()->get_id();
-
-	std::stringstream ss;
-	std::hash<std::string> h;
-
-	ss << source_id << "-" << target_id;
+	std::hash<std::uint64_t> h;
 
-	const std::size_t hash = h(ss.str());
+	const std::uint64_t key = edge::create_key(
+		edge->get_source()->get_id(), edge->get_target()->get_id());
 
-	return hash;
+	return h(key);
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,210 @@
+#include <graph_compressed_graph.h>
+
+#include <algorithm>
+#include <cassert>
+
+#include <graph.h>
+#include <graph_csr_graph.h>
+#include <graph_edge_source.h>
+
+namespace graph
+{
+
+const std::uint32_t compressed_graph::invalid_index;
+
+compressed_graph::compressed_graph()
+	:
+	_offsets(1, 0),
+	_edge_count(0),
+	_valid(true)
+{
+}
+
+compressed_graph::compressed_graph(const csr_graph* g)
+	:
+	_edge_count(0),
+	_valid(true)
+{
+	const std::uint32_t vertex_count = g->get_vertex_count();
+	std::vector<std::uint64_t> offsets(g->get_offsets(), g->get_offsets() + vertex_count + 1);
+	std::vector<std::uint32_t> neighbors(
+		g->get_targets(), g->get_targets() + g->get_edge_count());
+
+	encode(offsets, &neighbors);
+}
+
+compressed_graph::compressed_graph(
+	edge_source* edges,
+	const bool create_directed_graph)
+	:
+	_offsets(1, 0),
+	_edge_count(0),
+	_valid(false)
+{
+	// First pass: degrees, which give the position of every list.
+	std::vector<std::uint64_t> offsets(edges->get_vertex_count() + 1, 0);
+
+	const auto count = [&offsets](const std::uint32_t source)
+	{
+		if(source + 2 > offsets.size())
+			offsets.resize(source + 2, 0);
+		++offsets[source + 1];
+	};
+
+	if(!edges->read_edges(
+		[&](const graph::edge_record& record)
+		{
+			count(record.source_id);
+			if(!create_directed_graph)
+				count(record.target_id);
+			else if(record.target_id + 2 > offsets.size())
+				offsets.resize(record.target_id + 2, 0);
+			return true;
+		}))
+	{
+		return;
+	}
+
+	for(std::size_t i = 1; i < offsets.size(); ++i)
+		offsets[i] += offsets[i - 1];
+
+	// Second pass: the neighbors, 4 bytes per edge until they are encoded.
+	// The source has to deliver the same edges as in the first pass.
+	std::vector<std::uint32_t> neighbors(offsets.back());
+	std::vector<std::uint64_t> positions(offsets.begin(), offsets.end() - 1);
+	std::uint64_t neighbor_count = 0;
+
+	const auto add = [&](const std::uint32_t source, const std::uint32_t target)
+	{
+		if(source >= positions.size() || target >= positions.size() ||
+			positions[source] == offsets[source + 1])
+		{
+			return false;
+		}
+
+		neighbors[positions[source]++] = target;
+		++neighbor_count;
+		return true;
+	};
+
+	bool same_edges = true;
+
+	if(!edges->read_edges(
+		[&](const graph::edge_record& record)
+		{
+			same_edges =
+				add(record.source_id, record.target_id) &&
+				(create_directed_graph || add(record.target_id, record.source_id));
+			return same_edges;
+		}) ||
+		!same_edges || neighbor_count != neighbors.size())
+	{
+		return;
+	}
+
+	encode(offsets, &neighbors);
+	_valid = true;
+}
+
+compressed_graph::~compressed_graph()
+{
+}
+
+bool compressed_graph::is_valid(void) const
+{
+	return _valid;
+}
+
+std::uint32_t compressed_graph::get_vertex_count(void) const
+{
+	return static_cast<std::uint32_t>(_offsets.size() - 1);
+}
+
+std::uint64_t compressed_graph::get_edge_count(void) const
+{
+	return _edge_count;
+}
+
+std::uint32_t compressed_graph::get_degree(const std::uint32_t index) const
+{
+	const std::uint8_t* position = _data.data() + _offsets[index];
+	return static_cast<std::uint32_t>(read_varint(&position));
+}
+
+std::pair<compressed_graph::neighbor_iterator, compressed_graph::neighbor_iterator>
+	compressed_graph::get_neighbors(const std::uint32_t index) const
+{
+	const std::uint8_t* position = _data.data() + _offsets[index];
+	const std::uint32_t degree = static_cast<std::uint32_t>(read_varint(&position));
+
+	return std::make_pair(
+		neighbor_iterator(position, degree, index),
+		neighbor_iterator(nullptr, 0, index));
+}
+
+std::size_t compressed_graph::get_memory_size(void) const
+{
+	return
+		_offsets.capacity() * sizeof(std::uint64_t) +
+		_data.capacity() * sizeof(std::uint8_t);
+}
+
+void compressed_graph::write_varint(
+	std::uint64_t value, std::vector<std::uint8_t>* data)
+{
+	while(value >= 0x80)
+	{
+		data->push_back(static_cast<std::uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	data->push_back(static_cast<std::uint8_t>(value));
+}
+
+void compressed_graph::encode(
+	const std::vector<std::uint64_t>& offsets,
+	std::vector<std::uint32_t>* neighbors)
+{
+	const std::size_t vertex_count = offsets.size() - 1;
+
+	_offsets.clear();
+	_offsets.reserve(vertex_count + 1);
+	_data.clear();
+
+	// Most gaps of a sparse graph fit in one or two bytes.
+	_data.reserve(vertex_count + neighbors->size() * 2);
+
+	for(std::size_t v = 0; v < vertex_count; ++v)
+	{
+		const auto begin = neighbors->begin() + offsets[v];
+		const auto end = neighbors->begin() + offsets[v + 1];
+
+		std::sort(begin, end);
+
+		_offsets.push_back(_data.size());
+		write_varint(end - begin, &_data);
+
+		if(begin == end)
+			continue;
+
+		// zigzag: small negative and positive differences get small codes
+		const std::int64_t difference =
+			static_cast<std::int64_t>(*begin) - static_cast<std::int64_t>(v);
+
+		write_varint(
+			(static_cast<std::uint64_t>(difference) << 1) ^
+			static_cast<std::uint64_t>(difference >> 63),
+			&_data);
+
+		for(auto it = begin + 1; it != end; ++it)
+			write_varint(*it - *(it - 1), &_data);
+	}
+
+	_offsets.push_back(_data.size());
+	_data.shrink_to_fit();
+	_edge_count = neighbors->size();
+
+	// The temporary lists are not needed any more.
+	std::vector<std::uint32_t>().swap(*neighbors);
+}
+
+}
@@ -0,0 +1,519 @@
+#include <graph_csr_graph.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+
+#include <graph.h>
+#include <graph_vertex.h>
+#include <graph_edge.h>
+#include <graph_mapped_file.h>
+
+namespace graph
+{
+
+namespace
+{
+
+//
+// Layout of a snapshot file:
+// - snapshot_header
+// - ids (vertex_count), offsets (vertex_count + 1), targets (edge_count)
+// - weights, costs, capacities (edge_count), balances (vertex_count), each
+//   only if the flag in attributes is set
+// Every array starts at a multiple of 8 bytes, so the double arrays can be
+// used in place from the mapped file.
+//
+struct snapshot_header
+{
+	char magic[8];
+	std::uint32_t version;
+
+	//
+	// snapshot_byte_order as written by the creating machine.
+	//
+	std::uint32_t byte_order;
+	std::uint32_t attributes;
+	std::uint32_t reserved;
+	std::uint64_t vertex_count;
+	std::uint64_t edge_count;
+};
+
+const char snapshot_magic[8] = { 'G', 'R', 'A', 'P', 'H', 'C', 'S', 'R' };
+const std::uint32_t snapshot_byte_order = 0x01020304;
+
+enum snapshot_attribute : std::uint32_t
+{
+	snapshot_weights = 1 << 0,
+	snapshot_costs = 1 << 1,
+	snapshot_capacities = 1 << 2,
+	snapshot_balances = 1 << 3,
+};
+
+const std::uint32_t snapshot_all_attributes =
+	snapshot_weights | snapshot_costs | snapshot_capacities | snapshot_balances;
+
+std::size_t align_section(const std::size_t size)
+{
+	return (size + 7) & ~static_cast<std::size_t>(7);
+}
+
+//
+// Write an array and pad it to the next multiple of 8 bytes.
+//
+template<typename T>
+void write_section(std::ofstream& fs, const T* data, const std::size_t count)
+{
+	static const char padding[8] = {};
+	const std::size_t size = count * sizeof(T);
+
+	fs.write(reinterpret_cast<const char*>(data), size);
+	fs.write(padding, align_section(size) - size);
+}
+
+//
+// Returns the array at position and moves position behind it.
+//
+template<typename T>
+const T* read_section(const char** position, const std::size_t count)
+{
+	const T* result = reinterpret_cast<const T*>(*position);
+	*position += align_section(count * sizeof(T));
+	return result;
+}
+
+//
+// Check the topology arrays of a mapped snapshot in O(n + m), so a corrupted
+// file cannot send the algorithms outside of the arrays.
+//
+bool is_valid_topology(
+	const std::size_t n,
+	const std::size_t m,
+	const std::uint32_t* ids,
+	const std::uint32_t* offsets,
+	const std::uint32_t* targets)
+{
+	if(offsets[0] != 0 || offsets[n] != m)
+		return false;
+
+	for(std::size_t i = 0; i < n; ++i)
+	{
+		if(offsets[i + 1] < offsets[i] || (i != 0 && ids[i] <= ids[i - 1]))
+			return false;
+	}
+
+	for(std::size_t e = 0; e < m; ++e)
+	{
+		if(targets[e] >= n)
+			return false;
+	}
+
+	return true;
+}
+
+}
+
+const std::uint32_t csr_graph::invalid_index;
+const std::uint32_t csr_graph::snapshot_version;
+
+csr_graph::csr_graph()
+	:
+	_offsets(1, 0)
+{
+	use_vectors();
+}
+
+csr_graph::csr_graph(const graph* g)
+{
+	const double missing = std::numeric_limits<double>::quiet_NaN();
+	const std::uint32_t vertex_count = g->get_vertex_count();
+	const std::uint32_t edge_count = g->get_edge_count();
+	bool any_weight = false, any_cost = false, any_capacity = false;
+	bool any_balance = false;
+
+	_ids.reserve(vertex_count);
+	_offsets.reserve(vertex_count + 1);
+	_targets.reserve(edge_count);
+
+	// Vertex ids must be known before the targets can be translated.
+	for(const vertex* v : g->get_vertices())
+	{
+		_ids.push_back(v->get_id());
+		any_balance = any_balance || v->has_balance();
+
+		for(const edge* e : v->get_edges())
+		{
+			any_weight = any_weight || e->has_weight();
+			any_cost = any_cost || e->has_cost();
+			any_capacity = any_capacity || e->has_capacity();
+		}
+	}
+
+	assert(std::is_sorted(std::begin(_ids), std::end(_ids)));
+
+	// get_index works on the arrays
+	use_vectors();
+
+	if(any_weight)
+		_weights.reserve(edge_count);
+	if(any_cost)
+		_costs.reserve(edge_count);
+	if(any_capacity)
+		_capacities.reserve(edge_count);
+	if(any_balance)
+		_balances.reserve(vertex_count);
+
+	// Fill the edge arrays vertex by vertex
+	for(const vertex* v : g->get_vertices())
+	{
+		_offsets.push_back(_targets.size());
+
+		if(any_balance)
+			_balances.push_back(v->has_balance() ? v->get_balance() : missing);
+
+		for(const edge* e : v->get_edges())
+		{
+			const std::uint32_t target_index = get_index(e->get_target()->get_id());
+			assert(target_index != invalid_index);
+
+			_targets.push_back(target_index);
+
+			if(any_weight)
+				_weights.push_back(e->has_weight() ? e->get_weight() : missing);
+			if(any_cost)
+				_costs.push_back(e->has_cost() ? e->get_cost() : missing);
+			if(any_capacity)
+				_capacities.push_back(e->has_capacity() ? e->get_capacity() : missing);
+		}
+	}
+	_offsets.push_back(_targets.size());
+
+	assert(_ids.size() == vertex_count);
+	assert(_targets.size() == edge_count);
+
+	use_vectors();
+}
+
+csr_graph::csr_graph(const csr_graph& rhs)
+{
+	*this = rhs;
+}
+
+csr_graph::csr_graph(csr_graph&& rhs)
+{
+	*this = std::move(rhs);
+}
+
+csr_graph::~csr_graph()
+{
+}
+
+csr_graph& csr_graph::operator=(const csr_graph& rhs)
+{
+	if(this == &rhs)
+		return *this;
+
+	_ids = rhs._ids;
+	_offsets = rhs._offsets;
+	_targets = rhs._targets;
+	_weights = rhs._weights;
+	_costs = rhs._costs;
+	_capacities = rhs._capacities;
+	_balances = rhs._balances;
+
+	// A mapped snapshot is shared, owned arrays are copied.
+	_file = rhs._file;
+
+	if(_file)
+		use_arrays(rhs);
+	else
+		use_vectors();
+
+	return *this;
+}
+
+csr_graph& csr_graph::operator=(csr_graph&& rhs)
+{
+	if(this == &rhs)
+		return *this;
+
+	_ids = std::move(rhs._ids);
+	_offsets = std::move(rhs._offsets);
+	_targets = std::move(rhs._targets);
+	_weights = std::move(rhs._weights);
+	_costs = std::move(rhs._costs);
+	_capacities = std::move(rhs._capacities);
+	_balances = std::move(rhs._balances);
+	_file = std::move(rhs._file);
+
+	if(_file)
+		use_arrays(rhs);
+	else
+		use_vectors();
+
+	// The moved from graph is empty.
+	rhs._ids.clear();
+	rhs._offsets.assign(1, 0);
+	rhs._targets.clear();
+	rhs._weights.clear();
+	rhs._costs.clear();
+	rhs._capacities.clear();
+	rhs._balances.clear();
+	rhs._file.reset();
+	rhs.use_vectors();
+
+	return *this;
+}
+
+void csr_graph::use_vectors(void)
+{
+	_vertex_count = _ids.size();
+	_edge_count = _targets.size();
+	_id_data = _ids.data();
+	_offset_data = _offsets.data();
+	_target_data = _targets.data();
+	_weight_data = _weights.empty() ? nullptr : _weights.data();
+	_cost_data = _costs.empty() ? nullptr : _costs.data();
+	_capacity_data = _capacities.empty() ? nullptr : _capacities.data();
+	_balance_data = _balances.empty() ? nullptr : _balances.data();
+}
+
+void csr_graph::use_arrays(const csr_graph& rhs)
+{
+	_vertex_count = rhs._vertex_count;
+	_edge_count = rhs._edge_count;
+	_id_data = rhs._id_data;
+	_offset_data = rhs._offset_data;
+	_target_data = rhs._target_data;
+	_weight_data = rhs._weight_data;
+	_cost_data = rhs._cost_data;
+	_capacity_data = rhs._capacity_data;
+	_balance_data = rhs._balance_data;
+}
+
+bool csr_graph::write_snapshot(const std::string& file_name) const
+{
+	std::ofstream fs(file_name.c_str(), std::ios::binary | std::ios::trunc);
+	snapshot_header header;
+
+	if(!fs)
+		return false;
+
+	std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+	header.version = snapshot_version;
+	header.byte_order = snapshot_byte_order;
+	header.attributes =
+		(has_weights() ? snapshot_weights : 0) |
+		(has_costs() ? snapshot_costs : 0) |
+		(has_capacities() ? snapshot_capacities : 0) |
+		(has_balances() ? snapshot_balances : 0);
+	header.reserved = 0;
+	header.vertex_count = _vertex_count;
+	header.edge_count = _edge_count;
+
+	fs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	write_section(fs, _id_data, _vertex_count);
+	write_section(fs, _offset_data, _vertex_count + 1);
+	write_section(fs, _target_data, _edge_count);
+
+	if(has_weights())
+		write_section(fs, _weight_data, _edge_count);
+	if(has_costs())
+		write_section(fs, _cost_data, _edge_count);
+	if(has_capacities())
+		write_section(fs, _capacity_data, _edge_count);
+	if(has_balances())
+		write_section(fs, _balance_data, _vertex_count);
+
+	fs.close();
+	return !fs.fail();
+}
+
+bool csr_graph::read_snapshot(const std::string& file_name, csr_graph* result)
+{
+	std::shared_ptr<const mapped_file> file =
+		std::make_shared<const mapped_file>(file_name);
+	snapshot_header header;
+
+	if(file->get_size() < sizeof(header))
+		return false;
+
+	std::memcpy(&header, file->get_data(), sizeof(header));
+
+	if(std::memcmp(header.magic, snapshot_magic, sizeof(header.magic)) != 0 ||
+		header.version != snapshot_version ||
+		header.byte_order != snapshot_byte_order ||
+		(header.attributes & ~snapshot_all_attributes) != 0 ||
+		header.vertex_count >= invalid_index ||
+		header.edge_count >= invalid_index)
+	{
+		return false;
+	}
+
+	const std::size_t n = header.vertex_count;
+	const std::size_t m = header.edge_count;
+	std::size_t expected_size = sizeof(header) +
+		align_section(n * sizeof(std::uint32_t)) +
+		align_section((n + 1) * sizeof(std::uint32_t)) +
+		align_section(m * sizeof(std::uint32_t));
+
+	if(header.attributes & snapshot_weights)
+		expected_size += m * sizeof(double);
+	if(header.attributes & snapshot_costs)
+		expected_size += m * sizeof(double);
+	if(header.attributes & snapshot_capacities)
+		expected_size += m * sizeof(double);
+	if(header.attributes & snapshot_balances)
+		expected_size += n * sizeof(double);
+
+	if(file->get_size() != expected_size)
+		return false;
+
+	const char* position = file->get_data() + sizeof(header);
+	csr_graph snapshot;
+
+	snapshot._vertex_count = n;
+	snapshot._edge_count = m;
+	snapshot._id_data = read_section<std::uint32_t>(&position, n);
+	snapshot._offset_data = read_section<std::uint32_t>(&position, n + 1);
+	snapshot._target_data = read_section<std::uint32_t>(&position, m);
+
+	if(!is_valid_topology(n, m,
+		snapshot._id_data, snapshot._offset_data, snapshot._target_data))
+	{
+		return false;
+	}
+
+	snapshot._weight_data = (header.attributes & snapshot_weights) ?
+		read_section<double>(&position, m) : nullptr;
+	snapshot._cost_data = (header.attributes & snapshot_costs) ?
+		read_section<double>(&position, m) : nullptr;
+	snapshot._capacity_data = (header.attributes & snapshot_capacities) ?
+		read_section<double>(&position, m) : nullptr;
+	snapshot._balance_data = (header.attributes & snapshot_balances) ?
+		read_section<double>(&position, n) : nullptr;
+
+	// The arrays stay valid as long as a csr_graph holds the file.
+	snapshot._file = std::move(file);
+	*result = std::move(snapshot);
+
+	return true;
+}
+
+void csr_graph::create_transpose(
+	csr_graph* result, std::vector<std::uint32_t>* edge_index) const
+{
+	const std::uint32_t n = _vertex_count;
+	const std::uint32_t m = _edge_count;
+	csr_graph transpose;
+
+	transpose._ids.assign(_id_data, _id_data + n);
+	transpose._offsets.assign(n + 1, 0);
+	transpose._targets.resize(m);
+	if(has_weights())
+		transpose._weights.resize(m);
+	if(has_costs())
+		transpose._costs.resize(m);
+	if(has_capacities())
+		transpose._capacities.resize(m);
+	if(has_balances())
+		transpose._balances.assign(_balance_data, _balance_data + n);
+	if(edge_index != nullptr)
+		edge_index->resize(m);
+
+	// Count the incoming edges, offsets[i + 1] is the in degree of i
+	for(std::uint32_t e = 0; e < m; ++e)
+		++transpose._offsets[_target_data[e] + 1];
+
+	for(std::uint32_t i = 0; i < n; ++i)
+		transpose._offsets[i + 1] += transpose._offsets[i];
+
+	// Place every edge at the next free position of its target
+	std::vector<std::uint32_t> position(
+		transpose._offsets.cbegin(), transpose._offsets.cend() - 1);
+
+	for(std::uint32_t source = 0; source < n; ++source)
+	{
+		for(std::uint32_t e = _offset_data[source]; e < _offset_data[source + 1]; ++e)
+		{
+			const std::uint32_t p = position[_target_data[e]]++;
+
+			transpose._targets[p] = source;
+			if(edge_index != nullptr)
+				(*edge_index)[p] = e;
+			if(_weight_data != nullptr)
+				transpose._weights[p] = _weight_data[e];
+			if(_cost_data != nullptr)
+				transpose._costs[p] = _cost_data[e];
+			if(_capacity_data != nullptr)
+				transpose._capacities[p] = _capacity_data[e];
+		}
+	}
+
+	transpose.use_vectors();
+	*result = std::move(transpose);
+}
+
+std::uint32_t csr_graph::get_vertex_count(void) const
+{
+	return _vertex_count;
+}
+
+std::uint32_t csr_graph::get_edge_count(void) const
+{
+	return _edge_count;
+}
+
+std::uint32_t csr_graph::get_index(const std::uint32_t id) const
+{
+	// Loaded graphs use the ids 0..n-1, so the id is mostly the index.
+	if(id < _vertex_count && _id_data[id] == id)
+		return id;
+
+	const std::uint32_t* ids_end = _id_data + _vertex_count;
+	const std::uint32_t* iter = std::lower_bound(_id_data, ids_end, id);
+
+	if(iter == ids_end || *iter != id)
+		return invalid_index;
+
+	return static_cast<std::uint32_t>(iter - _id_data);
+}
+
+std::uint32_t csr_graph::get_id(const std::uint32_t index) const
+{
+	return _id_data[index];
+}
+
+bool csr_graph::has_weights(void) const
+{
+	return _weight_data != nullptr;
+}
+
+bool csr_graph::has_costs(void) const
+{
+	return _cost_data != nullptr;
+}
+
+bool csr_graph::has_capacities(void) const
+{
+	return _capacity_data != nullptr;
+}
+
+bool csr_graph::has_balances(void) const
+{
+	return _balance_data != nullptr;
+}
+
+const std::uint32_t* csr_graph::get_offsets(void) const
+{
+	return _offset_data;
+}
+
+const std::uint32_t* csr_graph::get_targets(void) const
+{
+	return _target_data;
+}
+
+}
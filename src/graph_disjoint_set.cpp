@@ -0,0 +1,84 @@
+#include <graph_disjoint_set.h>
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+namespace graph
+{
+
+disjoint_set::disjoint_set(const std::uint32_t size)
+	:
+	_set_count(0)
+{
+	grow(size);
+}
+
+disjoint_set::~disjoint_set()
+{
+}
+
+void disjoint_set::grow(const std::uint32_t size)
+{
+	const std::uint32_t old_size = get_size();
+
+	if(size <= old_size)
+		return;
+
+	_parents.resize(size);
+	std::iota(_parents.begin() + old_size, _parents.end(), old_size);
+	_sizes.resize(size, 1);
+	_set_count += size - old_size;
+}
+
+std::uint32_t disjoint_set::find(std::uint32_t element)
+{
+	assert(element < get_size());
+
+	// Path halving: point every second element to its grandparent.
+	while(_parents[element] != element)
+	{
+		_parents[element] = _parents[_parents[element]];
+		element = _parents[element];
+	}
+
+	return element;
+}
+
+bool disjoint_set::unite(const std::uint32_t lhs, const std::uint32_t rhs)
+{
+	grow(std::max(lhs, rhs) + 1);
+
+	std::uint32_t lhs_root = find(lhs);
+	std::uint32_t rhs_root = find(rhs);
+
+	if(lhs_root == rhs_root)
+		return false;
+
+	// The smaller set is attached to the larger one.
+	if(_sizes[lhs_root] < _sizes[rhs_root])
+		std::swap(lhs_root, rhs_root);
+
+	_parents[rhs_root] = lhs_root;
+	_sizes[lhs_root] += _sizes[rhs_root];
+	--_set_count;
+
+	return true;
+}
+
+std::uint32_t disjoint_set::get_size(void) const
+{
+	return static_cast<std::uint32_t>(_parents.size());
+}
+
+std::uint32_t disjoint_set::get_set_count(void) const
+{
+	return _set_count;
+}
+
+std::uint32_t disjoint_set::get_set_size(const std::uint32_t element)
+{
+	return _sizes[find(element)];
+}
+
+}
@@ -1,8 +1,6 @@
 #include <graph_edge.h>
 #include <cassert>
 #include <functional>
-#include <string>
-#include <sstream>
 #include <graph_vertex.h>
 #include <iostream>
 #include <memory>
@@ -15,6 +13,14 @@ edge::edge()
 	_source = nullptr;
 	_target = nullptr;
 	_twin = nullptr;
+
+	_weight = 0.0;
+	_cost = 0.0;
+	_capacity = 0.0;
+	_attributes = 0;
+	_position = 0;
+	_out_position = 0;
+	_in_position = 0;
 }
 
 edge::~edge()
@@ -22,10 +28,7 @@ edge::~edge()
 	_source = nullptr;
 	_target = nullptr;
 	_twin = nullptr;
-
-	_weight.reset(nullptr);
-	_cost.reset(nullptr);
-	_capacity.reset(nullptr);
+	_attributes = 0;
 }
 
 void edge::set_source(const vertex* new_vertex)
@@ -60,62 +63,68 @@ void edge::set_twin(const edge* new_twin)
 
 bool edge::has_weight(void) const
 {
-	return _weight != nullptr;
+	return (_attributes & attribute_weight) != 0;
 }
 
 double edge::get_weight(void) const
 {
 	assert(has_weight());
-	return *_weight;
+	return _weight;
 }
 
 void edge::set_weight(const double value)
 {
-	_weight.reset(new double(value));
+	_weight = value;
+	_attributes |= attribute_weight;
 }
 
 bool edge::has_cost(void) const
 {
-	return _cost != nullptr;
+	return (_attributes & attribute_cost) != 0;
 }
 
 double edge::get_cost(void) const
 {
 	assert(has_cost());
-	return *_cost;
+	return _cost;
 }
 
 void edge::set_cost(const double value)
 {
-	_cost.reset(new double(value));
+	_cost = value;
+	_attributes |= attribute_cost;
 }
 
 bool edge::has_capacity(void) const
 {
-	return _capacity != nullptr;
+	return (_attributes & attribute_capacity) != 0;
 }
 
 double edge::get_capacity(void) const
 {
 	assert(has_capacity());
-	return *_capacity;
+	return _capacity;
 }
 
 void edge::set_capacity(const double value)
 {
-	_capacity.reset(new double(value));
+	_capacity = value;
+	_attributes |= attribute_capacity;
+}
+
+void edge::assign_attributes(const edge* e)
+{
+	_weight = e->_weight;
+	_cost = e->_cost;
+	_capacity = e->_capacity;
+	_attributes = e->_attributes;
 }
 
 std::shared_ptr<edge> edge::create_copy(void) const
 {
 	std::shared_ptr<edge> e = std::make_shared<edge>();
 
-	if(has_weight())
-		e->set_weight(get_weight());
-	if(has_capacity())
-		e->set_capacity(get_capacity());
-	if(has_cost())
-		e->set_cost(get_cost());
+	e->assign_attributes(this);
 
 	return e;
 }
@@ -127,21 +136,33 @@ std::size_t edge::get_hash(void) const
 
 std::size_t edge::create_hash(const edge* e)
 {
-	std::stringstream ss;
-	std::hash<std::string> h;
+	return create_hash(e->get_source()->get_id(), e->get_target()->get_id());
+}
 
-	if(e->get_source()->get_id() < e->get_target()->get_id())
-	{
-		ss << e->get_source()->get_id() << "-" << e->get_target()->get_id();
-	}
-	else
-	{
-		ss << e->get_target()->get_id() << "-" << e->get_source()->get_id();
-	}
+std::size_t edge::create_hash(
+	const std::uint32_t source_id, const std::uint32_t target_id)
+{
+	std::hash<std::uint64_t> h;
 
-	const std::size_t hash = h(ss.str());
+	const std::uint64_t key = create_undirected_key(source_id, target_id);
+	const std::size_t hash = h(key);
 
 	return hash;
 }
 
+std::uint64_t edge::create_key(
+	const std::uint32_t source_id, const std::uint32_t target_id)
+{
+	return (static_cast<std::uint64_t>(source_id) << 32) | target_id;
+}
+
+std::uint64_t edge::create_undirected_key(
+	const std::uint32_t source_id, const std::uint32_t target_id)
+{
+	if(source_id < target_id)
+		return create_key(source_id, target_id);
+	else
+		return create_key(target_id, source_id);
+}
+
 }
@@ -0,0 +1,107 @@
+#include <graph_edge_source.h>
+
+#include <graph_text_parser.h>
+
+namespace graph
+{
+
+edge_source::~edge_source()
+{
+}
+
+file_edge_source::file_edge_source(
+	const std::string& file_name,
+	const edge_format format)
+	:
+	_file(file_name),
+	_format(format),
+	_vertex_count(0),
+	_edges(nullptr),
+	_valid(false)
+{
+	text_parser parser(_file.get_data(), _file.get_data() + _file.get_size());
+
+	_valid = _file.is_open() && parser.read(&_vertex_count);
+
+	if(_valid && format == edge_format::edge_list_minimum_cost_flow)
+	{
+		for(std::uint32_t i = 0; i < _vertex_count && _valid; ++i)
+		{
+			double balance = 0.0;
+			_valid = parser.read(&balance);
+		}
+	}
+	else if(_valid && format == edge_format::edge_list_matching)
+	{
+		std::uint32_t set_separator = 0;
+		_valid = parser.read(&set_separator);
+	}
+
+	_edges = parser.get_position();
+}
+
+file_edge_source::~file_edge_source()
+{
+}
+
+std::uint32_t file_edge_source::get_vertex_count(void) const
+{
+	return _vertex_count;
+}
+
+bool file_edge_source::read_edges(const edge_consumer& consumer)
+{
+	if(!_valid)
+		return false;
+
+	text_parser parser(_edges, _file.get_data() + _file.get_size());
+
+	if(_format == edge_format::adjacent_matrix)
+	{
+		// Only the upper triangle, the matrix is symmetric.
+		for(std::uint32_t row = 0; row < _vertex_count; ++row)
+		{
+			for(std::uint32_t col = 0; col < _vertex_count; ++col)
+			{
+				std::uint32_t adjacent = 0;
+
+				if(!parser.read(&adjacent))
+					return false;
+
+				if(adjacent && col >= row && !consumer({ row, col }))
+					return true;
+			}
+		}
+
+		return true;
+	}
+
+	while(!parser.at_end())
+	{
+		graph::edge_record record;
+
+		if(!parser.read(&record.source_id) || !parser.read(&record.target_id))
+			return false;
+
+		switch(_format)
+		{
+		case edge_format::edge_list_weighted:
+			if(!parser.read(&record.weight))
+				return false;
+			break;
+		case edge_format::edge_list_minimum_cost_flow:
+			if(!parser.read(&record.cost) || !parser.read(&record.capacity))
+				return false;
+			break;
+		default:
+			break;
+		}
+
+		if(!consumer(record))
+			return true;
+	}
+
+	return true;
+}
+
+}
@@ -0,0 +1,339 @@
+#include <graph_exporter.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <graph.h>
+#include <graph_buffered_writer.h>
+#include <graph_csr_graph.h>
+#include <graph_edge_source.h>
+
+namespace graph
+{
+
+const char exporter::result_magic[4] = { 'G', 'R', 'E', 'S' };
+const std::uint32_t exporter::result_version;
+const std::uint32_t exporter::result_distances;
+const std::uint32_t exporter::result_flow;
+
+namespace
+{
+
+//
+// Returns true for one edge of every undirected pair and for all directed
+// edges.
+//
+bool is_first_of_pair(const edge* e)
+{
+	if(!e->has_twin())
+		return true;
+
+	const std::uint32_t source_id = e->get_source()->get_id();
+	const std::uint32_t target_id = e->get_target()->get_id();
+
+	if(source_id != target_id)
+		return source_id < target_id;
+
+	return e < e->get_twin();
+}
+
+//
+// Returns true if predicate holds for every edge.
+//
+template<typename F>
+bool all_edges(const graph& graph, F predicate)
+{
+	for(const edge* e : graph.get_edges())
+	{
+		if(!predicate(e))
+			return false;
+	}
+	return true;
+}
+
+//
+// Returns the largest vertex id + 1.
+//
+std::uint32_t get_id_limit(const graph& graph)
+{
+	std::uint32_t limit = 0;
+
+	for(const vertex* v : graph.get_vertices())
+		limit = std::max(limit, v->get_id() + 1);
+
+	return limit;
+}
+
+void write_header(
+	buffered_writer* writer,
+	const std::uint32_t kind,
+	const std::uint64_t count)
+{
+	exporter::result_header header;
+
+	std::memcpy(header.magic, exporter::result_magic, sizeof(header.magic));
+	header.version = exporter::result_version;
+	header.kind = kind;
+	header.reserved = 0;
+	header.count = count;
+
+	writer->write_bytes(&header, sizeof(header));
+}
+
+}
+
+exporter::exporter()
+{
+}
+
+exporter::~exporter()
+{
+}
+
+bool exporter::save_tgf(const std::string& file_name, const graph& graph)
+{
+	// The label "capacity/cost" needs both values.
+	if(!all_edges(graph, [](const edge* e) { return e->has_capacity() == e->has_cost(); }))
+		return false;
+
+	buffered_writer writer(file_name);
+
+	if(!writer.is_open())
+		return false;
+
+	for(const vertex* v : graph.get_vertices())
+	{
+		writer.write(v->get_id());
+		writer.write('\t');
+		writer.write(v->get_id());
+		if(v->has_balance())
+		{
+			writer.write('/');
+			writer.write(v->get_balance());
+		}
+		writer.write('\n');
+	}
+	writer.write(std::string_view("#\n"));
+
+	for(const edge* e : graph.get_edges())
+	{
+		if(!is_first_of_pair(e))
+			continue;
+
+		writer.write(e->get_source()->get_id());
+		writer.write('\t');
+		writer.write(e->get_target()->get_id());
+		if(e->has_capacity())
+		{
+			writer.write('\t');
+			writer.write(e->get_capacity());
+			writer.write('/');
+			writer.write(e->get_cost());
+		}
+		else if(e->has_weight())
+		{
+			writer.write('\t');
+			writer.write(e->get_weight());
+		}
+		writer.write('\n');
+	}
+
+	return writer.close();
+}
+
+bool exporter::save_edge_list(
+	const std::string& file_name,
+	const graph& graph,
+	const edge_format format)
+{
+	if(format != edge_format::edge_list &&
+		format != edge_format::edge_list_weighted &&
+		format != edge_format::edge_list_minimum_cost_flow)
+	{
+		return false;
+	}
+
+	// Every edge needs the values of the format.
+	if(format == edge_format::edge_list_weighted &&
+		!all_edges(graph, [](const edge* e) { return e->has_weight(); }))
+	{
+		return false;
+	}
+
+	if(format == edge_format::edge_list_minimum_cost_flow &&
+		!all_edges(graph, [](const edge* e) { return e->has_cost() && e->has_capacity(); }))
+	{
+		return false;
+	}
+
+	buffered_writer writer(file_name);
+	const std::uint32_t vertex_count = get_id_limit(graph);
+
+	if(!writer.is_open())
+		return false;
+
+	writer.write(vertex_count);
+	writer.write('\n');
+
+	if(format == edge_format::edge_list_minimum_cost_flow)
+	{
+		for(std::uint32_t id = 0; id < vertex_count; ++id)
+		{
+			const vertex* v = graph.get_vertex(id);
+
+			writer.write(v != nullptr && v->has_balance() ? v->get_balance() : 0.0);
+			writer.write('\n');
+		}
+	}
+
+	for(const edge* e : graph.get_edges())
+	{
+		if(!is_first_of_pair(e))
+			continue;
+
+		writer.write(e->get_source()->get_id());
+		writer.write('\t');
+		writer.write(e->get_target()->get_id());
+
+		if(format == edge_format::edge_list_weighted)
+		{
+			writer.write('\t');
+			writer.write(e->get_weight());
+		}
+		else if(format == edge_format::edge_list_minimum_cost_flow)
+		{
+			writer.write('\t');
+			writer.write(e->get_cost());
+			writer.write('\t');
+			writer.write(e->get_capacity());
+		}
+		writer.write('\n');
+	}
+
+	return writer.close();
+}
+
+bool exporter::save_binary(const std::string& file_name, const graph& graph)
+{
+	const csr_graph snapshot(&graph);
+	return snapshot.write_snapshot(file_name);
+}
+
+bool exporter::save_distances(
+	const std::string& file_name,
+	const std::unordered_map<std::uint32_t, double>& distances)
+{
+	buffered_writer writer(file_name);
+	std::vector<std::pair<std::uint32_t, double>> sorted(
+		distances.cbegin(), distances.cend());
+
+	if(!writer.is_open())
+		return false;
+
+	std::sort(sorted.begin(), sorted.end());
+
+	for(const std::pair<std::uint32_t, double>& distance : sorted)
+	{
+		writer.write(distance.first);
+		writer.write('\t');
+		writer.write(distance.second);
+		writer.write('\n');
+	}
+
+	return writer.close();
+}
+
+bool exporter::save_distances(
+	const std::string& file_name,
+	const std::vector<double>& distances)
+{
+	buffered_writer writer(file_name);
+
+	if(!writer.is_open())
+		return false;
+
+	writer.write(static_cast<std::uint64_t>(distances.size()));
+	writer.write('\n');
+
+	for(const double distance : distances)
+	{
+		writer.write(distance);
+		writer.write('\n');
+	}
+
+	return writer.close();
+}
+
+bool exporter::save_distances_binary(
+	const std::string& file_name,
+	const std::vector<double>& distances)
+{
+	buffered_writer writer(file_name);
+
+	if(!writer.is_open())
+		return false;
+
+	write_header(&writer, result_distances, distances.size());
+	writer.write_bytes(distances.data(), distances.size() * sizeof(double));
+
+	return writer.close();
+}
+
+bool exporter::save_flow(const std::string& file_name, const flow_map& flow_per_edge)
+{
+	buffered_writer writer(file_name);
+
+	if(!writer.is_open())
+		return false;
+
+	for(const flow_record& record : get_flow_records(flow_per_edge))
+	{
+		writer.write(record.source_id);
+		writer.write('\t');
+		writer.write(record.target_id);
+		writer.write('\t');
+		writer.write(record.flow);
+		writer.write('\n');
+	}
+
+	return writer.close();
+}
+
+bool exporter::save_flow_binary(const std::string& file_name, const flow_map& flow_per_edge)
+{
+	buffered_writer writer(file_name);
+	const std::vector<flow_record> records = get_flow_records(flow_per_edge);
+
+	if(!writer.is_open())
+		return false;
+
+	write_header(&writer, result_flow, records.size());
+	writer.write_bytes(records.data(), records.size() * sizeof(flow_record));
+
+	return writer.close();
+}
+
+std::vector<exporter::flow_record> exporter::get_flow_records(const flow_map& flow_per_edge)
+{
+	std::vector<flow_record> records;
+
+	records.reserve(flow_per_edge.size());
+	for(const std::pair<const edge* const, double>& flow : flow_per_edge)
+	{
+		records.push_back({
+			flow.first->get_source()->get_id(),
+			flow.first->get_target()->get_id(),
+			flow.second });
+	}
+
+	std::sort(records.begin(), records.end(),
+		[](const flow_record& lhs, const flow_record& rhs)
+		{
+			return lhs.source_id != rhs.source_id ?
+				lhs.source_id < rhs.source_id : lhs.target_id < rhs.target_id;
+		});
+
+	return records;
+}
+
+}
@@ -0,0 +1,647 @@
+#include <graph_generator.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include <graph.h>
+
+namespace graph
+{
+
+namespace
+{
+
+//
+// Uniform integer in [0, bound), without the modulo bias.
+//
+std::uint64_t uniform(std::mt19937_64& engine, const std::uint64_t bound)
+{
+	assert(bound != 0);
+
+	// Values below threshold would make the small results more likely.
+	const std::uint64_t threshold = (0 - bound) % bound;
+
+	while(true)
+	{
+		const std::uint64_t value = engine();
+
+		if(value >= threshold)
+			return value % bound;
+	}
+}
+
+//
+// Uniform double in [0, 1) from the upper 53 bits.
+//
+double uniform_real(std::mt19937_64& engine)
+{
+	return static_cast<double>(engine() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+struct point
+{
+	double x;
+	double y;
+};
+
+double distance(const point& lhs, const point& rhs)
+{
+	return std::hypot(lhs.x - rhs.x, lhs.y - rhs.y);
+}
+
+std::vector<point> create_points(std::mt19937_64& engine, const std::uint32_t count)
+{
+	std::vector<point> points(count);
+
+	for(point& p : points)
+	{
+		p.x = uniform_real(engine);
+		p.y = uniform_real(engine);
+	}
+
+	return points;
+}
+
+//
+// Pseudo random permutation of [0, size): a balanced Feistel network on the
+// smallest domain 2^(2 * half_bits) >= size, values beyond size are
+// encrypted again (cycle walking). The first m values are m distinct
+// indices without storing the used ones.
+//
+class permutation
+{
+public:
+	permutation(std::mt19937_64& engine, const std::uint64_t size)
+		:
+		_size(size),
+		_half_bits(1)
+	{
+		while(_half_bits < 32 && (std::uint64_t(1) << (2 * _half_bits)) < size)
+			++_half_bits;
+
+		for(std::uint64_t& key : _keys)
+			key = engine();
+	}
+
+private:
+	std::uint64_t _size;
+	unsigned _half_bits;
+	std::uint64_t _keys[4];
+
+	//
+	// Finalizer of splitmix64.
+	//
+	static std::uint64_t mix(std::uint64_t value)
+	{
+		value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+		value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+		return value ^ (value >> 31);
+	}
+
+	std::uint64_t encrypt(const std::uint64_t value) const
+	{
+		const std::uint64_t mask = (std::uint64_t(1) << _half_bits) - 1;
+		std::uint64_t left = value >> _half_bits;
+		std::uint64_t right = value & mask;
+
+		for(const std::uint64_t key : _keys)
+		{
+			const std::uint64_t next_right = left ^ (mix(right ^ key) & mask);
+
+			left = right;
+			right = next_right;
+		}
+
+		return (left << _half_bits) | right;
+	}
+
+public:
+	std::uint64_t operator()(const std::uint64_t index) const
+	{
+		assert(index < _size);
+
+		std::uint64_t value = index;
+
+		do
+		{
+			value = encrypt(value);
+		}
+		while(value >= _size);
+
+		return value;
+	}
+};
+
+//
+// Returns the pair lower < higher of the index higher * (higher - 1) / 2 + lower.
+//
+void triangular_pair(
+	const std::uint64_t index, std::uint32_t* lower, std::uint32_t* higher)
+{
+	std::uint64_t h = static_cast<std::uint64_t>(
+		(1.0 + std::sqrt(1.0 + 8.0 * static_cast<double>(index))) / 2.0);
+
+	// Correct the rounding of the double square root.
+	while(h > 1 && h * (h - 1) / 2 > index)
+		--h;
+	while((h + 1) * h / 2 <= index)
+		++h;
+
+	*higher = static_cast<std::uint32_t>(h);
+	*lower = static_cast<std::uint32_t>(index - h * (h - 1) / 2);
+}
+
+//
+// Seed of the balances, independent of the edges.
+//
+const std::uint64_t balance_seed = 0x9e3779b97f4a7c15;
+
+}
+
+generator::generator(
+	const kind k,
+	const std::uint32_t vertex_count,
+	const std::uint64_t edge_count,
+	const std::uint64_t seed)
+	:
+	_kind(k),
+	_vertex_count(vertex_count),
+	_edge_count(edge_count),
+	_seed(seed),
+	_valid(true),
+	_scale(0),
+	_probabilities(),
+	_column_count(0),
+	_left_count(0),
+	_radius(0.0)
+{
+}
+
+generator::~generator()
+{
+}
+
+generator generator::erdos_renyi(
+	const std::uint32_t vertex_count,
+	const std::uint64_t edge_count,
+	const std::uint64_t seed)
+{
+	generator result(kind::erdos_renyi, vertex_count, edge_count, seed);
+
+	result._valid =
+		edge_count <= std::uint64_t(vertex_count) * (vertex_count - 1) / 2;
+
+	return result;
+}
+
+generator generator::rmat(
+	const unsigned scale,
+	const std::uint64_t edge_count,
+	const std::uint64_t seed,
+	const double a,
+	const double b,
+	const double c)
+{
+	const bool valid =
+		scale < 32 && a >= 0.0 && b >= 0.0 && c >= 0.0 && a + b + c <= 1.0;
+
+	generator result(
+		kind::rmat, valid ? std::uint32_t(1) << scale : 0, edge_count, seed);
+
+	result._valid = valid;
+	result._scale = scale;
+	result._probabilities[0] = a;
+	result._probabilities[1] = b;
+	result._probabilities[2] = c;
+
+	return result;
+}
+
+generator generator::grid(
+	const std::uint32_t row_count,
+	const std::uint32_t column_count,
+	const std::uint64_t seed)
+{
+	const std::uint64_t edge_count =
+		row_count == 0 || column_count == 0 ? 0 :
+		std::uint64_t(row_count) * (column_count - 1) +
+		std::uint64_t(row_count - 1) * column_count;
+
+	const std::uint64_t vertex_count = std::uint64_t(row_count) * column_count;
+
+	generator result(
+		kind::grid, static_cast<std::uint32_t>(vertex_count), edge_count, seed);
+
+	result._valid = vertex_count <= std::numeric_limits<std::uint32_t>::max();
+	result._column_count = column_count;
+
+	return result;
+}
+
+generator generator::random_geometric(
+	const std::uint32_t vertex_count,
+	const double radius,
+	const std::uint64_t seed)
+{
+	generator result(kind::random_geometric, vertex_count, 0, seed);
+
+	result._valid = radius > 0.0;
+	result._radius = radius;
+
+	return result;
+}
+
+generator generator::complete_euclidean(
+	const std::uint32_t vertex_count, const std::uint64_t seed)
+{
+	return generator(
+		kind::complete_euclidean,
+		vertex_count,
+		std::uint64_t(vertex_count) * (vertex_count - 1) / 2,
+		seed);
+}
+
+generator generator::bipartite(
+	const std::uint32_t left_count,
+	const std::uint32_t right_count,
+	const std::uint64_t edge_count,
+	const std::uint64_t seed)
+{
+	generator result(kind::bipartite, left_count + right_count, edge_count, seed);
+
+	result._valid = (left_count > 0 && right_count > 0) || edge_count == 0;
+	result._left_count = left_count;
+
+	return result;
+}
+
+generator generator::minimum_cost_flow(
+	const std::uint32_t vertex_count,
+	const std::uint64_t edge_count,
+	const std::uint32_t max_balance,
+	const std::uint64_t seed)
+{
+	generator result(
+		kind::minimum_cost_flow, vertex_count, edge_count + vertex_count, seed);
+
+	// A cycle of two vertices would be antiparallel, and every other
+	// vertex pair can be used once.
+	if(vertex_count <= 2 ||
+		edge_count > std::uint64_t(vertex_count) * (vertex_count - 1) / 2 - vertex_count)
+	{
+		result._valid = false;
+		return result;
+	}
+
+	std::mt19937_64 engine(seed ^ balance_seed);
+
+	// The vertices 2i and 2i + 1 get opposite balances, so the balances sum
+	// up to 0 and stay in range. The last vertex of an odd count gets 0.
+	result._balances.assign(vertex_count, 0.0);
+
+	for(std::uint32_t i = 0; i + 1 < vertex_count; i += 2)
+	{
+		const double balance =
+			static_cast<double>(uniform(engine, 2 * std::uint64_t(max_balance) + 1)) - max_balance;
+
+		result._balances[i] = balance;
+		result._balances[i + 1] = -balance;
+	}
+
+	return result;
+}
+
+std::uint32_t generator::get_vertex_count(void) const
+{
+	return _vertex_count;
+}
+
+bool generator::read_edges(const edge_consumer& consumer)
+{
+	if(!_valid)
+		return false;
+
+	std::mt19937_64 engine(_seed);
+
+	switch(_kind)
+	{
+	case kind::erdos_renyi: read_erdos_renyi(engine, consumer); break;
+	case kind::rmat: read_rmat(engine, consumer); break;
+	case kind::grid: read_grid(engine, consumer); break;
+	case kind::random_geometric: read_random_geometric(engine, consumer); break;
+	case kind::complete_euclidean: read_complete_euclidean(engine, consumer); break;
+	case kind::bipartite: read_bipartite(engine, consumer); break;
+	case kind::minimum_cost_flow: read_minimum_cost_flow(engine, consumer); break;
+	}
+
+	return true;
+}
+
+bool generator::is_valid(void) const
+{
+	return _valid;
+}
+
+bool generator::is_directed(void) const
+{
+	return
+		_kind == kind::rmat ||
+		_kind == kind::bipartite ||
+		_kind == kind::minimum_cost_flow;
+}
+
+const std::vector<double>& generator::get_balances(void) const
+{
+	return _balances;
+}
+
+void generator::build(graph& graph)
+{
+	if(!_valid)
+		return;
+
+	std::vector<graph::edge_record> records;
+
+	records.reserve(_edge_count);
+
+	// Balanced vertices before the edges, add_edges only creates plain ones.
+	for(std::uint32_t i = 0; i < _balances.size(); ++i)
+		graph.add_vertex(i, _balances[i]);
+
+	read_edges(
+		[&records](const graph::edge_record& record)
+		{
+			records.push_back(record);
+			return true;
+		});
+
+	graph.add_edges(records, _vertex_count, is_directed());
+}
+
+void generator::read_erdos_renyi(
+	std::mt19937_64& engine, const edge_consumer& consumer) const
+{
+	// Distinct indices of the n(n-1)/2 vertex pairs without loops.
+	const permutation pairs(
+		engine, std::uint64_t(_vertex_count) * (_vertex_count - 1) / 2);
+
+	for(std::uint64_t i = 0; i < _edge_count; ++i)
+	{
+		graph::edge_record record;
+
+		triangular_pair(pairs(i), &record.source_id, &record.target_id);
+		record.weight = uniform_real(engine);
+
+		if(!consumer(record))
+			return;
+	}
+}
+
+void generator::read_rmat(
+	std::mt19937_64& engine, const edge_consumer& consumer) const
+{
+	const double a = _probabilities[0];
+	const double ab = a + _probabilities[1];
+	const double abc = ab + _probabilities[2];
+
+	for(std::uint64_t i = 0; i < _edge_count; ++i)
+	{
+		graph::edge_record record;
+
+		record.source_id = 0;
+		record.target_id = 0;
+
+		// Descend into one of the four quadrants per bit.
+		for(unsigned bit = 0; bit < _scale; ++bit)
+		{
+			const double quadrant = uniform_real(engine);
+
+			record.source_id <<= 1;
+			record.target_id <<= 1;
+
+			if(quadrant < a)
+				continue;
+			else if(quadrant < ab)
+				record.target_id |= 1;
+			else if(quadrant < abc)
+				record.source_id |= 1;
+			else
+			{
+				record.source_id |= 1;
+				record.target_id |= 1;
+			}
+		}
+
+		record.weight = uniform_real(engine);
+
+		if(!consumer(record))
+			return;
+	}
+}
+
+void generator::read_grid(
+	std::mt19937_64& engine, const edge_consumer& consumer) const
+{
+	if(_column_count == 0)
+		return;
+
+	const std::uint32_t row_count = _vertex_count / _column_count;
+
+	for(std::uint32_t row = 0; row < row_count; ++row)
+	{
+		for(std::uint32_t column = 0; column < _column_count; ++column)
+		{
+			const std::uint32_t id = row * _column_count + column;
+			graph::edge_record record;
+
+			record.source_id = id;
+
+			if(column + 1 < _column_count)
+			{
+				record.target_id = id + 1;
+				record.weight = uniform_real(engine);
+				if(!consumer(record))
+					return;
+			}
+
+			if(row + 1 < row_count)
+			{
+				record.target_id = id + _column_count;
+				record.weight = uniform_real(engine);
+				if(!consumer(record))
+					return;
+			}
+		}
+	}
+}
+
+void generator::read_random_geometric(
+	std::mt19937_64& engine, const edge_consumer& consumer) const
+{
+	const std::vector<point> points = create_points(engine, _vertex_count);
+
+	// Cells of at least the radius, so neighbors are in adjacent cells. Not
+	// more cells than points, to bound the memory for small radii.
+	const std::uint32_t cell_count = static_cast<std::uint32_t>(std::max(1.0, std::min(
+		std::floor(1.0 / _radius), std::floor(std::sqrt(double(_vertex_count))))));
+
+	const auto cell_of = [cell_count](const double value)
+	{
+		return std::min(static_cast<std::uint32_t>(value * cell_count), cell_count - 1);
+	};
+
+	// Counting sort of the points by cell (row major).
+	std::vector<std::uint32_t> cell_begin(std::size_t(cell_count) * cell_count + 1, 0);
+	std::vector<std::uint32_t> sorted(_vertex_count);
+
+	for(const point& p : points)
+		++cell_begin[cell_of(p.y) * cell_count + cell_of(p.x) + 1];
+
+	for(std::size_t i = 1; i < cell_begin.size(); ++i)
+		cell_begin[i] += cell_begin[i - 1];
+
+	{
+		std::vector<std::uint32_t> position(cell_begin.begin(), cell_begin.end() - 1);
+
+		for(std::uint32_t i = 0; i < _vertex_count; ++i)
+			sorted[position[cell_of(points[i].y) * cell_count + cell_of(points[i].x)]++] = i;
+	}
+
+	// Compare every point with the points of its own cell and the
+	// neighboring cells, every pair is reported by the smaller id.
+	for(std::uint32_t source = 0; source < _vertex_count; ++source)
+	{
+		const std::uint32_t x = cell_of(points[source].x);
+		const std::uint32_t y = cell_of(points[source].y);
+
+		for(std::uint32_t cy = (y == 0 ? 0 : y - 1); cy <= std::min(y + 1, cell_count - 1); ++cy)
+		{
+			for(std::uint32_t cx = (x == 0 ? 0 : x - 1); cx <= std::min(x + 1, cell_count - 1); ++cx)
+			{
+				const std::size_t cell = std::size_t(cy) * cell_count + cx;
+
+				for(std::uint32_t i = cell_begin[cell]; i < cell_begin[cell + 1]; ++i)
+				{
+					const std::uint32_t target = sorted[i];
+
+					if(target <= source)
+						continue;
+
+					const double weight = distance(points[source], points[target]);
+
+					if(weight >= _radius)
+						continue;
+
+					graph::edge_record record;
+
+					record.source_id = source;
+					record.target_id = target;
+					record.weight = weight;
+
+					if(!consumer(record))
+						return;
+				}
+			}
+		}
+	}
+}
+
+void generator::read_complete_euclidean(
+	std::mt19937_64& engine, const edge_consumer& consumer) const
+{
+	const std::vector<point> points = create_points(engine, _vertex_count);
+
+	for(std::uint32_t source = 0; source < _vertex_count; ++source)
+	{
+		for(std::uint32_t target = source + 1; target < _vertex_count; ++target)
+		{
+			graph::edge_record record;
+
+			record.source_id = source;
+			record.target_id = target;
+			record.weight = distance(points[source], points[target]);
+
+			if(!consumer(record))
+				return;
+		}
+	}
+}
+
+void generator::read_bipartite(
+	std::mt19937_64& engine, const edge_consumer& consumer) const
+{
+	const std::uint32_t right_count = _vertex_count - _left_count;
+
+	for(std::uint64_t i = 0; i < _edge_count; ++i)
+	{
+		graph::edge_record record;
+
+		record.source_id = static_cast<std::uint32_t>(uniform(engine, _left_count));
+		record.target_id = _left_count + static_cast<std::uint32_t>(uniform(engine, right_count));
+
+		if(!consumer(record))
+			return;
+	}
+}
+
+void generator::read_minimum_cost_flow(
+	std::mt19937_64& engine, const edge_consumer& consumer) const
+{
+	double supply = 0.0;
+
+	for(const double balance : _balances)
+		supply += std::max(balance, 0.0);
+
+	// The cycle can carry the whole supply to every vertex.
+	for(std::uint32_t i = 0; i < _vertex_count; ++i)
+	{
+		graph::edge_record record;
+
+		record.source_id = i;
+		record.target_id = (i + 1) % _vertex_count;
+		record.cost = 1000.0;
+		record.capacity = supply;
+
+		if(!consumer(record))
+			return;
+	}
+
+	// The flow algorithms expect neither parallel nor antiparallel edges,
+	// so every vertex pair is used once. The pairs lower < higher - 1 are
+	// the pairs (lower, higher - 1) of n - 1 vertices, which leaves out the
+	// cycle pairs (i, i + 1). Counting lower down from higher - 2 makes the
+	// last cycle pair (0, n - 1) the last index, which is never drawn.
+	const permutation pairs(
+		engine, std::uint64_t(_vertex_count - 1) * (_vertex_count - 2) / 2 - 1);
+
+	for(std::uint64_t i = _vertex_count; i < _edge_count; ++i)
+	{
+		graph::edge_record record;
+		std::uint32_t lower = 0, higher = 0;
+
+		triangular_pair(pairs(i - _vertex_count), &lower, &higher);
+		lower = higher - 1 - lower;
+		++higher;
+
+		if(engine() & 1)
+		{
+			record.source_id = lower;
+			record.target_id = higher;
+		}
+		else
+		{
+			record.source_id = higher;
+			record.target_id = lower;
+		}
+
+		record.cost = static_cast<double>(uniform(engine, 100) + 1);
+		record.capacity = static_cast<double>(uniform(engine, 100) + 1);
+
+		if(!consumer(record))
+			return;
+	}
+}
+
+}
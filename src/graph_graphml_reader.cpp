@@ -0,0 +1,311 @@
+#include <graph_graphml_reader.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+namespace graph
+{
+
+namespace
+{
+
+std::string_view trim(std::string_view text)
+{
+	const std::string_view whitespace(" \t\r\n");
+	const std::size_t begin = text.find_first_not_of(whitespace);
+
+	if(begin == std::string_view::npos)
+		return std::string_view();
+
+	return text.substr(begin, text.find_last_not_of(whitespace) - begin + 1);
+}
+
+bool parse_number(const std::string_view& text, double* value)
+{
+	const std::string_view number = trim(text);
+
+	if(number.empty())
+		return false;
+
+	const std::from_chars_result result =
+		std::from_chars(number.data(), number.data() + number.size(), *value);
+
+	return result.ec == std::errc() && result.ptr == number.data() + number.size();
+}
+
+//
+// Parse a label "a" or "a/b". Returns the number of values, 0 if the label
+// is not numeric.
+//
+std::size_t parse_label(std::string_view text, double* values)
+{
+	for(std::size_t count = 0; count < 2; ++count)
+	{
+		const std::size_t slash = text.find('/');
+
+		if(!parse_number(text.substr(0, slash), &values[count]))
+			return 0;
+
+		if(slash == std::string_view::npos)
+			return count + 1;
+
+		text = text.substr(slash + 1);
+	}
+
+	return 0;
+}
+
+}
+
+const std::uint32_t graphml_reader::invalid_id;
+
+graphml_reader::graphml_reader()
+	:
+	_depth(0),
+	_valid(true),
+	_edge(false),
+	_text_target(text_target::none),
+	_text_depth(0),
+	_data_attribute(attribute::none)
+{
+}
+
+graphml_reader::~graphml_reader()
+{
+}
+
+bool graphml_reader::read(const char* begin, const char* end)
+{
+	xml_parser parser(begin, end);
+
+	return parser.parse(this) && _valid && _depth == 0;
+}
+
+void graphml_reader::build(graph& graph, const bool create_directed_graph) const
+{
+	const std::size_t node_count = _label_ids.size();
+
+	// Labels are only usable as ids if every node has its own.
+	std::vector<std::uint32_t> label_ids(_label_ids);
+	std::sort(label_ids.begin(), label_ids.end());
+
+	const bool use_labels =
+		(label_ids.empty() || label_ids.back() != invalid_id) &&
+		std::adjacent_find(label_ids.begin(), label_ids.end()) == label_ids.end();
+
+	const bool has_balances =
+		std::any_of(_balances.begin(), _balances.end(),
+			[](const double balance) { return !std::isnan(balance); });
+
+	std::vector<std::uint32_t> ids(node_count);
+
+	for(std::uint32_t i = 0; i < node_count; ++i)
+	{
+		ids[i] = use_labels ? _label_ids[i] : i;
+
+		// A flow network needs a balance on every vertex.
+		if(has_balances)
+			graph.add_vertex(ids[i], std::isnan(_balances[i]) ? 0.0 : _balances[i]);
+		else
+			graph.add_vertex(ids[i]);
+	}
+
+	std::vector<graph::edge_record> records(_records);
+
+	for(graph::edge_record& record : records)
+	{
+		record.source_id = ids[record.source_id];
+		record.target_id = ids[record.target_id];
+	}
+
+	graph.add_edges(records, 0, create_directed_graph);
+}
+
+void graphml_reader::start_element(
+	const std::string_view& name,
+	const std::vector<xml_attribute>& attributes)
+{
+	++_depth;
+
+	const std::string_view local = local_name(name);
+
+	if(local == "key")
+	{
+		const std::string_view attribute_name = find_attribute(attributes, "attr.name");
+		key k = { std::string(find_attribute(attributes, "id")), attribute::none };
+
+		if(attribute_name == "weight")
+			k.value = attribute::weight;
+		else if(attribute_name == "cost")
+			k.value = attribute::cost;
+		else if(attribute_name == "capacity")
+			k.value = attribute::capacity;
+		else if(attribute_name == "balance")
+			k.value = attribute::balance;
+
+		_keys.push_back(k);
+	}
+	else if(local == "node")
+	{
+		const std::string_view id = find_attribute(attributes, "id");
+
+		if(id.empty())
+			_valid = false;
+
+		_nodes.push_back(get_node_index(id));
+	}
+	else if(local == "edge")
+	{
+		const std::string_view source = find_attribute(attributes, "source");
+		const std::string_view target = find_attribute(attributes, "target");
+
+		if(source.empty() || target.empty())
+			_valid = false;
+
+		_record = graph::edge_record();
+		_record.source_id = get_node_index(source);
+		_record.target_id = get_node_index(target);
+		_edge = true;
+	}
+	else if(local == "data" && (_edge || !_nodes.empty()))
+	{
+		const std::string_view key_id = find_attribute(attributes, "key");
+
+		for(const key& k : _keys)
+		{
+			if(k.id != key_id)
+				continue;
+
+			// Balances belong to nodes, the other values to edges.
+			if(k.value != attribute::none &&
+				(k.value == attribute::balance) == !_edge)
+			{
+				_data_attribute = k.value;
+				collect_text(text_target::data);
+			}
+			break;
+		}
+	}
+	else if(local == "NodeLabel" && !_edge && !_nodes.empty())
+	{
+		collect_text(text_target::node_label);
+	}
+	else if(local == "EdgeLabel" && _edge)
+	{
+		collect_text(text_target::edge_label);
+	}
+}
+
+void graphml_reader::end_element(const std::string_view& name)
+{
+	// End tag without start tag
+	if(_depth == 0)
+	{
+		_valid = false;
+		return;
+	}
+
+	if(_text_target != text_target::none && _depth == _text_depth)
+	{
+		double values[2];
+
+		switch(_text_target)
+		{
+		case text_target::data:
+			if(!parse_number(_text, &values[0]))
+				_valid = false;
+			else if(_data_attribute == attribute::balance)
+				_balances[_nodes.back()] = values[0];
+			else if(_data_attribute == attribute::weight)
+				_record.weight = values[0];
+			else if(_data_attribute == attribute::cost)
+				_record.cost = values[0];
+			else if(_data_attribute == attribute::capacity)
+				_record.capacity = values[0];
+			break;
+		case text_target::node_label:
+		{
+			// "id" or "id/balance", <data> values take precedence.
+			const std::size_t count = parse_label(_text, values);
+			const std::uint32_t node = _nodes.back();
+
+			if(count > 0 && _label_ids[node] == invalid_id &&
+				values[0] >= 0 && values[0] < invalid_id &&
+				values[0] == std::floor(values[0]))
+			{
+				_label_ids[node] = static_cast<std::uint32_t>(values[0]);
+			}
+			if(count == 2 && std::isnan(_balances[node]))
+				_balances[node] = values[1];
+			break;
+		}
+		case text_target::edge_label:
+		{
+			// "weight" or "capacity/cost", <data> values take precedence.
+			const std::size_t count = parse_label(_text, values);
+
+			if(count == 1 && std::isnan(_record.weight))
+				_record.weight = values[0];
+			if(count == 2 && std::isnan(_record.capacity))
+				_record.capacity = values[0];
+			if(count == 2 && std::isnan(_record.cost))
+				_record.cost = values[1];
+			break;
+		}
+		default:
+			break;
+		}
+
+		_text_target = text_target::none;
+	}
+	else
+	{
+		const std::string_view local = local_name(name);
+
+		if(local == "node" && !_nodes.empty())
+		{
+			_nodes.pop_back();
+		}
+		else if(local == "edge" && _edge)
+		{
+			_records.push_back(_record);
+			_edge = false;
+		}
+	}
+
+	--_depth;
+}
+
+void graphml_reader::characters(const std::string_view& text)
+{
+	if(_text_target != text_target::none && _depth == _text_depth)
+		_text.append(text.data(), text.size());
+}
+
+std::uint32_t graphml_reader::get_node_index(const std::string_view& id)
+{
+	_node_id.assign(id.data(), id.size());
+
+	const auto found = _node_indices.find(_node_id);
+
+	if(found != _node_indices.end())
+		return found->second;
+
+	const std::uint32_t index = static_cast<std::uint32_t>(_label_ids.size());
+
+	_node_indices.emplace(_node_id, index);
+	_label_ids.push_back(invalid_id);
+	_balances.push_back(std::numeric_limits<double>::quiet_NaN());
+
+	return index;
+}
+
+void graphml_reader::collect_text(const text_target target)
+{
+	_text_target = target;
+	_text_depth = _depth;
+	_text.clear();
+}
+
+}
@@ -1,21 +1,259 @@
 #include <graph_loader.h>
 
+#include <algorithm>
 #include <cassert>
-#include <fstream>
-#include <iomanip>
+#include <string_view>
+#include <vector>
 
 #include <graph.h>
+#include <graph_csr_graph.h>
 #include <graph_edge.h>
+#include <graph_edge_source.h>
+#include <graph_graphml_reader.h>
 #include <graph_vertex.h>
+#include <graph_mapped_file.h>
+#include <graph_text_parser.h>
+#include <graph_thread_pool.h>
 
 
 namespace graph
 {
 
+namespace
+{
+
+//
+// Files with less edge data are parsed by one thread.
+//
+const std::size_t min_chunk_size = 1 << 20;
+
+//
+// Parse the edges in [begin, end) with parse_edge until it fails.
+// Returns false if a malformed record stopped the parsing.
+// Remark:
+// - The range is split at line ends into chunks, which are parsed in
+//   parallel into their own buffers.
+// - parse_edge returns false at the end of a chunk or on a malformed
+//   record. It leaves the parser in front of the malformed record, so a
+//   chunk was parsed completely if only whitespace is left.
+// - The records keep the order of the file. They end at the first
+//   malformed record in file order, independent of the chunk count.
+//
+template<typename F>
+bool parse_edges(
+	thread_pool* pool,
+	const char* begin,
+	const char* end,
+	std::vector<graph::edge_record>* records,
+	F parse_edge)
+{
+	const std::size_t size = end - begin;
+	const std::size_t chunk_count =
+		std::max<std::size_t>(std::min(pool->get_thread_count(), size / min_chunk_size), 1);
+
+	std::vector<const char*> boundaries(1, begin);
+
+	for(std::size_t i = 1; i < chunk_count; ++i)
+	{
+		const char* boundary = std::find(begin + size * i / chunk_count, end, '\n');
+
+		if(boundary != end)
+			++boundary;
+
+		boundaries.push_back(std::max(boundary, boundaries.back()));
+	}
+	boundaries.push_back(end);
+
+	std::vector<std::vector<graph::edge_record>> chunk_records(chunk_count);
+	std::vector<char> chunk_complete(chunk_count, false);
+
+	auto parse_chunk = [&](const std::size_t chunk)
+	{
+		text_parser parser(boundaries[chunk], boundaries[chunk + 1]);
+		graph::edge_record record;
+
+		while(parse_edge(&parser, &record))
+			chunk_records[chunk].push_back(record);
+
+		chunk_complete[chunk] = parser.at_end();
+	};
+
+	pool->parallel_for(chunk_count, parse_chunk);
+
+	// Merge the buffers up to the first incomplete chunk
+	std::size_t merge_count = 0;
+	std::size_t record_count = records->size();
+
+	while(merge_count < chunk_count)
+	{
+		record_count += chunk_records[merge_count].size();
+
+		if(!chunk_complete[merge_count++])
+			break;
+	}
+
+	records->reserve(record_count);
+
+	for(std::size_t chunk = 0; chunk < merge_count; ++chunk)
+		records->insert(records->end(), chunk_records[chunk].begin(), chunk_records[chunk].end());
+
+	return chunk_complete[merge_count - 1];
+}
+
+//
+// Read one record with read_fields. A malformed record is not consumed,
+// see parse_edges.
+//
+template<typename F>
+bool read_record(text_parser* parser, F read_fields)
+{
+	const text_parser record_start = *parser;
+
+	if(read_fields())
+		return true;
+
+	*parser = record_start;
+	return false;
+}
+
+//
+// Translate a 1-based DIMACS/METIS vertex number into a vertex id.
+//
+bool to_vertex_id(std::uint32_t* id, const std::uint32_t vertex_count)
+{
+	if(*id == 0 || *id > vertex_count)
+		return false;
+
+	--(*id);
+	return true;
+}
+
+//
+// Read the DIMACS lines in front of the arcs: comments, the problem line
+// "p <problem> <vertex count> <edge count>" and the node lines, which are
+// passed to read_node. Afterwards the parser is at the first arc line.
+// Returns false if the problem line is missing or of another problem.
+//
+template<typename F>
+bool read_dimacs_header(
+	text_parser* parser,
+	const std::string_view& problem,
+	std::uint32_t* vertex_count,
+	std::uint32_t* edge_count,
+	F read_node)
+{
+	bool problem_found = false;
+
+	while(true)
+	{
+		const text_parser line = *parser;
+		std::string_view tag;
+
+		if(!parser->read(&tag))
+			return problem_found;
+
+		if(tag == "a")
+		{
+			*parser = line;
+			return problem_found;
+		}
+
+		if(tag == "p")
+		{
+			std::string_view name;
+
+			if(problem_found ||
+				!parser->read(&name) || name != problem ||
+				!parser->read(vertex_count) || !parser->read(edge_count))
+			{
+				return false;
+			}
+			problem_found = true;
+		}
+		else if(tag == "n")
+		{
+			if(!problem_found || !read_node(parser))
+				return false;
+		}
+		else if(tag != "c")
+		{
+			return false;
+		}
+
+		parser->skip_line();
+	}
+}
+
+//
+// Parse the arc lines "a <source> <target> ..." of a DIMACS file, read_values
+// reads the values behind source and target. Other lines are skipped.
+//
+template<typename F>
+bool parse_dimacs_arcs(
+	thread_pool* pool,
+	const text_parser& parser,
+	const char* end,
+	const std::uint32_t vertex_count,
+	const std::uint32_t edge_count,
+	std::vector<graph::edge_record>* records,
+	F read_values)
+{
+	const bool complete = parse_edges(
+		pool, parser.get_position(), end,
+		records,
+		[&](text_parser* chunk_parser, graph::edge_record* record)
+		{
+			while(true)
+			{
+				const text_parser line = *chunk_parser;
+				std::string_view tag;
+
+				if(!chunk_parser->read(&tag))
+					return false;
+
+				if(tag == "a")
+				{
+					if(chunk_parser->read(&record->source_id) &&
+						chunk_parser->read(&record->target_id) &&
+						to_vertex_id(&record->source_id, vertex_count) &&
+						to_vertex_id(&record->target_id, vertex_count) &&
+						read_values(chunk_parser, record))
+					{
+						return true;
+					}
+
+					// The malformed arc is not consumed, see parse_edges.
+					*chunk_parser = line;
+					return false;
+				}
+
+				chunk_parser->skip_line();
+			}
+		});
+
+	return complete && records->size() == edge_count;
+}
+
+}
+
 loader::loader()
+	:
+	_thread_count(0),
+	_shared_pool(nullptr)
 {
 }
 
+void loader::set_thread_count(const std::size_t thread_count)
+{
+	_thread_count = thread_count;
+	_own_pool.reset();
+}
+
+void loader::set_thread_pool(thread_pool* pool)
+{
+	_shared_pool = pool;
+}
+
 loader::~loader()
 {
 }
@@ -75,16 +313,43 @@ void loader::load(
 {
 	std::string file_name = file_name_get(graph_file);
 
-	switch(graph_file)
+	switch(get_edge_format(graph_file))
 	{
-	case files::Graph1:
+	case edge_format::adjacent_matrix:
 		load_adjacent_matrix(file_name, graph);
 		break;
+	case edge_format::edge_list:
+		load_edge_list(file_name, graph);
+		break;
+	case edge_format::edge_list_weighted:
+		load_edge_list_weighted(file_name, graph, create_directed_graph);
+		break;
+	case edge_format::edge_list_minimum_cost_flow:
+		load_edge_list_minimum_cost_flow(file_name, graph);
+		break;
+	case edge_format::edge_list_matching:
+		load_edge_list_matching(file_name, graph);
+		break;
+	default: assert(false);
+	}
+}
+
+std::unique_ptr<edge_source> loader::open_edge_source(const files& graph_file)
+{
+	return std::unique_ptr<edge_source>(
+		new file_edge_source(file_name_get(graph_file), get_edge_format(graph_file)));
+}
+
+edge_format loader::get_edge_format(const files& graph_file) const
+{
+	switch(graph_file)
+	{
+	case files::Graph1:
+		return edge_format::adjacent_matrix;
 	case files::Graph2:
 	case files::Graph3:
 	case files::Graph4:
-		load_edge_list(file_name, graph);
-		break;
+		return edge_format::edge_list;
 	case files::G_1_2:
 	case files::G_1_20:
 	case files::G_1_200:
@@ -108,78 +373,363 @@ void loader::load(
 	case files::Fluss:
 	case files::Fluss2:
 	case files::Fluss3:
-		load_edge_list_weighted(file_name, graph, create_directed_graph);
-		break;
+		return edge_format::edge_list_weighted;
 	case files::Kostenminimal1:
 	case files::Kostenminimal2:
 	case files::Kostenminimal3:
 	case files::Kostenminimal4:
 	case files::Kostenminimal5:
 	case files::Kostenminimal6:
-		load_edge_list_minimum_cost_flow(file_name, graph);
-		break;
+		return edge_format::edge_list_minimum_cost_flow;
 	case files::Matching_100_100:
 	case files::Matching2_100_100:
-		load_edge_list_matching(file_name, graph);
-		break;
-	default: assert(false);
+		return edge_format::edge_list_matching;
 	}
+
+	assert(false);
+	return edge_format::edge_list;
 }
 
-void loader::load_adjacent_matrix(const std::string& file_name, graph& graph)
+bool loader::load_graphml(
+	const std::string& file_name,
+	graph& graph,
+	const bool create_directed_graph)
 {
-	std::fstream fs;
-	std::size_t vertex_count = 0;
+	const mapped_file file(file_name);
+	graphml_reader reader;
 
-	fs.open(file_name.c_str());
-	fs >> vertex_count;
+	if(!file.is_open() ||
+		!reader.read(file.get_data(), file.get_data() + file.get_size()))
+	{
+		return false;
+	}
 
-	// create vertices
+	reader.build(graph, create_directed_graph);
+	return true;
+}
+
+bool loader::load_dimacs_shortest_path(
+	const std::string& file_name, graph& graph)
+{
+	const mapped_file file(file_name);
+	text_parser parser(file.get_data(), file.get_data() + file.get_size());
+	std::uint32_t vertex_count = 0, edge_count = 0;
+
+	std::vector<graph::edge_record> records;
+
+	if(!read_dimacs_header(&parser, "sp", &vertex_count, &edge_count,
+		[](text_parser*) { return false; }))
+	{
+		return false;
+	}
+
+	// read arcs "a <source> <target> <length>"
+	if(!parse_dimacs_arcs(
+		get_thread_pool(), parser, file.get_data() + file.get_size(),
+		vertex_count, edge_count, &records,
+		[](text_parser* chunk_parser, graph::edge_record* record)
+		{
+			return chunk_parser->read(&record->weight);
+		}))
+	{
+		return false;
+	}
+
+	graph.add_edges(records, vertex_count, true);
+	return true;
+}
+
+bool loader::load_dimacs_maximum_flow(
+	const std::string& file_name,
+	graph& graph,
+	std::uint32_t* source_id,
+	std::uint32_t* target_id)
+{
+	const mapped_file file(file_name);
+	text_parser parser(file.get_data(), file.get_data() + file.get_size());
+	std::uint32_t vertex_count = 0, edge_count = 0;
+	bool source_found = false, target_found = false;
+
+	std::vector<graph::edge_record> records;
+
+	// node lines "n <id> s" and "n <id> t"
+	if(!read_dimacs_header(&parser, "max", &vertex_count, &edge_count,
+		[&](text_parser* header_parser)
+		{
+			std::uint32_t id = 0;
+			std::string_view kind;
+
+			if(!header_parser->read(&id) || !to_vertex_id(&id, vertex_count) ||
+				!header_parser->read(&kind))
+			{
+				return false;
+			}
+
+			if(kind == "s")
+			{
+				*source_id = id;
+				source_found = true;
+			}
+			else if(kind == "t")
+			{
+				*target_id = id;
+				target_found = true;
+			}
+			else
+			{
+				return false;
+			}
+			return true;
+		}) || !source_found || !target_found)
+	{
+		return false;
+	}
+
+	// read arcs "a <source> <target> <capacity>"
+	if(!parse_dimacs_arcs(
+		get_thread_pool(), parser, file.get_data() + file.get_size(),
+		vertex_count, edge_count, &records,
+		[](text_parser* chunk_parser, graph::edge_record* record)
+		{
+			return chunk_parser->read(&record->weight);
+		}))
+	{
+		return false;
+	}
+
+	graph.add_edges(records, vertex_count, true);
+	return true;
+}
+
+bool loader::load_dimacs_minimum_cost_flow(
+	const std::string& file_name, graph& graph)
+{
+	const mapped_file file(file_name);
+	text_parser parser(file.get_data(), file.get_data() + file.get_size());
+	std::uint32_t vertex_count = 0, edge_count = 0;
+
+	std::vector<graph::edge_record> records;
+	std::vector<double> balances;
+
+	// node lines "n <id> <supply>"
+	if(!read_dimacs_header(&parser, "min", &vertex_count, &edge_count,
+		[&](text_parser* header_parser)
+		{
+			std::uint32_t id = 0;
+			double balance = 0.0;
+
+			if(!header_parser->read(&id) || !to_vertex_id(&id, vertex_count) ||
+				!header_parser->read(&balance))
+			{
+				return false;
+			}
+
+			balances.resize(vertex_count, 0.0);
+			balances[id] = balance;
+			return true;
+		}))
+	{
+		return false;
+	}
+
+	// read arcs "a <source> <target> <lower bound> <capacity> <cost>"
+	if(!parse_dimacs_arcs(
+		get_thread_pool(), parser, file.get_data() + file.get_size(),
+		vertex_count, edge_count, &records,
+		[](text_parser* chunk_parser, graph::edge_record* record)
+		{
+			double lower_bound = 0.0;
+
+			return
+				chunk_parser->read(&lower_bound) && lower_bound == 0.0 &&
+				chunk_parser->read(&record->capacity) &&
+				chunk_parser->read(&record->cost);
+		}))
+	{
+		return false;
+	}
+
+	// create vertices, every vertex of a flow network has a balance
+	balances.resize(vertex_count, 0.0);
 	for(std::uint32_t i = 0; i < vertex_count; ++i)
-		graph.add_vertex(i);
+		graph.add_vertex(i, balances[i]);
 
-	// create edges
-	for(std::size_t row = 0; row < vertex_count; row++)
+	graph.add_edges(records, vertex_count, true);
+	return true;
+}
+
+bool loader::load_metis(const std::string& file_name, graph& graph)
+{
+	const mapped_file file(file_name);
+	const char* position = file.get_data();
+	const char* end = file.get_data() + file.get_size();
+
+	std::vector<graph::edge_record> records;
+
+	// The vertex of a line is its number, so the lines are read one by one
+	// and comment lines (%) are skipped.
+	const auto next_line = [&](text_parser* line)
+	{
+		while(position != end)
+		{
+			const char* line_end = std::find(position, end, '\n');
+			const char* first = position;
+
+			while(first != line_end && (*first == ' ' || *first == '\t'))
+				++first;
+
+			*line = text_parser(position, line_end);
+			position = line_end == end ? end : line_end + 1;
+
+			if(first == line_end || *first != '%')
+				return true;
+		}
+		return false;
+	};
+
+	// header "<vertex count> <edge count> [<format> [<constraint count>]]"
+	text_parser line(position, position);
+	std::uint32_t vertex_count = 0, edge_count = 0;
+	std::uint32_t format = 0, constraint_count = 1;
+
+	if(!next_line(&line) || !line.read(&vertex_count) || !line.read(&edge_count))
+		return false;
+
+	if(line.read(&format))
+		line.read(&constraint_count);
+
+	if(!line.at_end())
+		return false;
+
+	const bool has_edge_weights = format % 10 == 1;
+	const bool has_vertex_weights = format / 10 % 10 == 1;
+	const bool has_vertex_sizes = format / 100 % 10 == 1;
+
+	records.reserve(edge_count);
+
+	// read one line of neighbors per vertex
+	for(std::uint32_t source = 0; source < vertex_count; ++source)
+	{
+		double skipped = 0.0;
+
+		// A missing last line is an isolated vertex.
+		if(!next_line(&line) && source + 1 < vertex_count)
+			return false;
+
+		if(has_vertex_sizes && !line.read(&skipped))
+			return false;
+
+		for(std::uint32_t i = 0; has_vertex_weights && i < constraint_count; ++i)
+		{
+			if(!line.read(&skipped))
+				return false;
+		}
+
+		while(!line.at_end())
+		{
+			graph::edge_record record;
+
+			record.source_id = source;
+			if(!line.read(&record.target_id) ||
+				!to_vertex_id(&record.target_id, vertex_count) ||
+				(has_edge_weights && !line.read(&record.weight)))
+			{
+				return false;
+			}
+
+			// Every undirected edge is listed by both vertices.
+			if(source < record.target_id)
+				records.push_back(record);
+		}
+
+		line = text_parser(end, end);
+	}
+
+	if(records.size() != edge_count)
+		return false;
+
+	graph.add_edges(records, vertex_count, false);
+	return true;
+}
+
+bool loader::save_snapshot(const std::string& file_name, const graph& graph)
+{
+	const csr_graph snapshot(&graph);
+	return snapshot.write_snapshot(file_name);
+}
+
+bool loader::load_snapshot(const std::string& file_name, csr_graph* graph)
+{
+	return csr_graph::read_snapshot(file_name, graph);
+}
+
+thread_pool* loader::get_thread_pool(void)
+{
+	if(_shared_pool != nullptr)
+		return _shared_pool;
+
+	if(!_own_pool)
+		_own_pool.reset(new thread_pool(_thread_count));
+
+	return _own_pool.get();
+}
+
+void loader::load_adjacent_matrix(const std::string& file_name, graph& graph)
+{
+	const mapped_file file(file_name);
+	text_parser parser(file.get_data(), file.get_data() + file.get_size());
+	std::uint32_t vertex_count = 0;
+
+	std::vector<graph::edge_record> records;
+
+	parser.read(&vertex_count);
+
+	// read edges
+	for(std::uint32_t row = 0; row < vertex_count; row++)
 	{
-		for(std::size_t col = 0; col < vertex_count; col++)
+		for(std::uint32_t col = 0; col < vertex_count; col++)
 		{
-			bool adjacent = {};
+			std::uint32_t adjacent = 0;
 
-			fs >> adjacent;
+			parser.read(&adjacent);
 			if(adjacent && col >= row)
 			{
-				graph.add_undirected_edge(row, col);
+				records.push_back({ row, col });
 			}
 		}
 	}
 
+	// create vertices and edges
+	graph.add_edges(records, vertex_count, false);
+
 	assert(graph.get_vertex_count() == vertex_count);
 }
 
 void loader::load_edge_list(
 	const std::string& file_name, graph& graph)
 {
-	std::fstream fs;
+	const mapped_file file(file_name);
+	text_parser parser(file.get_data(), file.get_data() + file.get_size());
 	std::uint32_t vertex_count = 0;
 
-	fs.open(file_name.c_str());
-	fs >> vertex_count;
+	std::vector<graph::edge_record> records;
 
-	// create vertices
-	for(std::uint32_t i = 0; i < vertex_count; ++i)
-		graph.add_vertex(i);
+	parser.read(&vertex_count);
 
-	// create edges
-	while(true)
-	{
-		std::uint32_t source_id = {}, target_id = {};
-
-		fs >> source_id >> target_id;
-		if(fs.eof())
-			break;
+	// read edges
+	parse_edges(
+		get_thread_pool(), parser.get_position(), file.get_data() + file.get_size(),
+		&records,
+		[](text_parser* chunk_parser, graph::edge_record* record)
+		{
+			return read_record(chunk_parser, [&]()
+			{
+				return chunk_parser->read(&record->source_id) && chunk_parser->read(&record->target_id);
+			});
+		});
 
-		graph.add_undirected_edge(source_id, target_id);
-	}
+	// create vertices and edges
+	graph.add_edges(records, vertex_count, false);
 
 	assert(graph.get_vertex_count() == vertex_count);
 }
@@ -189,35 +739,31 @@ void loader::load_edge_list_weighted(
 	graph& graph,
 	const bool create_directed_graph)
 {
-	std::fstream fs;
+	const mapped_file file(file_name);
+	text_parser parser(file.get_data(), file.get_data() + file.get_size());
 	std::uint32_t vertex_count = 0;
 
-	fs.open(file_name.c_str());
-	fs >> vertex_count;
+	std::vector<graph::edge_record> records;
 
-	// create vertices
-	for(std::uint32_t i = 0; i < vertex_count; ++i)
-		graph.add_vertex(i);
+	parser.read(&vertex_count);
 
-	// create edges
-	while(true)
-	{
-		std::uint32_t source_id = {}, target_id = {};
-		double weight = {};
-
-		fs >> source_id >> target_id >> weight;
-		if(fs.eof())
-			break;
-
-		if(create_directed_graph)
+	// read edges
+	parse_edges(
+		get_thread_pool(), parser.get_position(), file.get_data() + file.get_size(),
+		&records,
+		[](text_parser* chunk_parser, graph::edge_record* record)
 		{
-			graph.add_directed_edge(source_id, target_id, weight);
-		}
-		else
-		{
-			graph.add_undirected_edge(source_id, target_id, weight);
-		}
-	}
+			return read_record(chunk_parser, [&]()
+			{
+				return
+					chunk_parser->read(&record->source_id) &&
+					chunk_parser->read(&record->target_id) &&
+					chunk_parser->read(&record->weight);
+			});
+		});
+
+	// create vertices and edges
+	graph.add_edges(records, vertex_count, create_directed_graph);
 
 	assert(graph.get_vertex_count() == vertex_count);
 }
@@ -226,33 +772,41 @@ void loader::load_edge_list_minimum_cost_flow(
 	const std::string& file_name,
 	graph& graph)
 {
-	std::fstream fs;
+	const mapped_file file(file_name);
+	text_parser parser(file.get_data(), file.get_data() + file.get_size());
 	std::uint32_t vertex_count = 0;
 
-	fs.open(file_name.c_str());
-	fs >> vertex_count;
+	std::vector<graph::edge_record> records;
+
+	parser.read(&vertex_count);
 
 	// create vertices
 	for(std::uint32_t i = 0; i < vertex_count; ++i)
 	{
 		double balance = {};
 
-		fs >> balance;
+		parser.read(&balance);
 		graph.add_vertex(i, balance);
 	}
 
-	// create edges
-	while(true)
-	{
-		std::uint32_t source_id = {}, target_id = {};
-		double cost = {}, capacity = {};
-
-		fs >> source_id >> target_id >> cost >> capacity;
-		if(fs.eof())
-			break;
+	// read edges
+	parse_edges(
+		get_thread_pool(), parser.get_position(), file.get_data() + file.get_size(),
+		&records,
+		[](text_parser* chunk_parser, graph::edge_record* record)
+		{
+			return read_record(chunk_parser, [&]()
+			{
+				return
+					chunk_parser->read(&record->source_id) &&
+					chunk_parser->read(&record->target_id) &&
+					chunk_parser->read(&record->cost) &&
+					chunk_parser->read(&record->capacity);
+			});
+		});
 
-		graph.add_directed_edge(source_id, target_id, cost, capacity);
-	}
+	// create edges
+	graph.add_edges(records, vertex_count, true);
 
 	assert(graph.get_vertex_count() == vertex_count);
 }
@@ -261,31 +815,30 @@ void loader::load_edge_list_matching(
 	const std::string& file_name,
 	graph& graph)
 {
-	std::fstream fs;
+	const mapped_file file(file_name);
+	text_parser parser(file.get_data(), file.get_data() + file.get_size());
 	std::uint32_t vertex_count = 0;
 	std::uint32_t vertex_count_first_group = 0;
 
-	fs.open(file_name.c_str());
-	fs >> vertex_count;
-	fs >> vertex_count_first_group;
-
-	// create vertices
-	for(std::uint32_t i = 0; i < vertex_count; ++i)
-	{
-		graph.add_vertex(i);
-	}
+	std::vector<graph::edge_record> records;
 
-	// create edges
-	while(true)
-	{
-		std::uint32_t source_id = {}, target_id = {};
+	parser.read(&vertex_count);
+	parser.read(&vertex_count_first_group);
 
-		fs >> source_id >> target_id;
-		if(fs.eof())
-			break;
+	// read edges
+	parse_edges(
+		get_thread_pool(), parser.get_position(), file.get_data() + file.get_size(),
+		&records,
+		[](text_parser* chunk_parser, graph::edge_record* record)
+		{
+			return read_record(chunk_parser, [&]()
+			{
+				return chunk_parser->read(&record->source_id) && chunk_parser->read(&record->target_id);
+			});
+		});
 
-		graph.add_directed_edge(source_id, target_id);
-	}
+	// create vertices and edges
+	graph.add_edges(records, vertex_count, true);
 
 	assert(graph.get_vertex_count() == vertex_count);
 }
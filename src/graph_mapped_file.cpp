@@ -0,0 +1,96 @@
+#include <graph_mapped_file.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GRAPH_MAPPED_FILE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace graph
+{
+
+mapped_file::mapped_file(const std::string& file_name)
+	:
+	_data(nullptr),
+	_size(0),
+	_open(false),
+	_mapping(nullptr)
+{
+#ifdef GRAPH_MAPPED_FILE_MMAP
+	const int fd = ::open(file_name.c_str(), O_RDONLY);
+	if(fd < 0)
+		return;
+
+	struct stat info;
+	if(::fstat(fd, &info) == 0)
+	{
+		_open = true;
+
+		// mmap does not support an empty range.
+		if(info.st_size > 0)
+		{
+			void* mapping = ::mmap(
+				nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+			if(mapping != MAP_FAILED)
+			{
+				::madvise(mapping, info.st_size, MADV_SEQUENTIAL);
+
+				_mapping = mapping;
+				_data = static_cast<const char*>(mapping);
+				_size = info.st_size;
+			}
+			else
+			{
+				_open = false;
+			}
+		}
+	}
+
+	// The mapping stays valid without the descriptor.
+	::close(fd);
+#else
+	std::ifstream fs(file_name.c_str(), std::ios::binary);
+	if(!fs)
+		return;
+
+	_open = true;
+	_buffer.assign(
+		std::istreambuf_iterator<char>(fs), std::istreambuf_iterator<char>());
+	_data = _buffer.data();
+	_size = _buffer.size();
+#endif
+}
+
+mapped_file::~mapped_file()
+{
+#ifdef GRAPH_MAPPED_FILE_MMAP
+	if(_mapping != nullptr)
+		::munmap(_mapping, _size);
+#endif
+	_mapping = nullptr;
+	_data = nullptr;
+	_size = 0;
+}
+
+bool mapped_file::is_open(void) const
+{
+	return _open;
+}
+
+const char* mapped_file::get_data(void) const
+{
+	return _data;
+}
+
+std::size_t mapped_file::get_size(void) const
+{
+	return _size;
+}
+
+}
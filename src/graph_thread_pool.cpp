@@ -0,0 +1,117 @@
+#include <graph_thread_pool.h>
+
+#include <algorithm>
+
+namespace graph
+{
+
+thread_pool::thread_pool(const std::size_t thread_count)
+	:
+	_thread_count(thread_count),
+	_body(nullptr),
+	_count(0),
+	_next(0),
+	_running(0),
+	_generation(0),
+	_stop(false)
+{
+	if(_thread_count == 0)
+		_thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+thread_pool::~thread_pool()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_start.notify_all();
+
+	for(std::thread& worker : _workers)
+		worker.join();
+}
+
+std::size_t thread_pool::get_thread_count(void) const
+{
+	return _thread_count;
+}
+
+std::size_t thread_pool::get_started_thread_count(void) const
+{
+	return _workers.size() + 1;
+}
+
+void thread_pool::parallel_for(
+	const std::size_t count,
+	const std::function<void(std::size_t)>& body)
+{
+	// Not worth waking up the workers
+	if(_thread_count == 1 || count < 2)
+	{
+		for(std::size_t i = 0; i < count; ++i)
+			body(i);
+		return;
+	}
+
+	// One loop at a time, another caller waits for the end of this one.
+	std::lock_guard<std::mutex> caller_lock(_caller_mutex);
+
+	// The calling thread is the first thread of the pool. The workers wait
+	// for the loop after the current generation.
+	if(_workers.empty())
+	{
+		_workers.reserve(_thread_count - 1);
+		for(std::size_t i = 1; i < _thread_count; ++i)
+			_workers.emplace_back(&thread_pool::run_worker, this, _generation);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_body = &body;
+		_count = count;
+		_next = 0;
+		_running = _workers.size();
+		++_generation;
+	}
+	_start.notify_all();
+
+	run_loop();
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	_done.wait(lock, [this] { return _running == 0; });
+	_body = nullptr;
+}
+
+void thread_pool::run_worker(std::uint64_t generation)
+{
+	while(true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_start.wait(lock, [&] { return _stop || _generation != generation; });
+
+			if(_stop)
+				return;
+
+			generation = _generation;
+		}
+
+		run_loop();
+
+		bool last = false;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			last = (--_running == 0);
+		}
+		if(last)
+			_done.notify_one();
+	}
+}
+
+void thread_pool::run_loop(void)
+{
+	for(std::size_t i = _next++; i < _count; i = _next++)
+		(*_body)(i);
+}
+
+}
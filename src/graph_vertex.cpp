@@ -3,6 +3,7 @@
 #include <graph_edge.h>
 #include <iostream>
 #include <algorithm>
+#include <cassert>
 
 namespace graph
 {
@@ -16,6 +17,7 @@ vertex::vertex(const vertex& rhs)
 {
 	_id = rhs._id;
 	_edges = rhs._edges;
+	_pointing_edges = rhs._pointing_edges;
 
 	if(rhs.has_balance())
 		set_balance(rhs.get_balance());
@@ -25,6 +27,7 @@ vertex::~vertex()
 {
 	_id = 0;
 	_edges.clear();
+	_pointing_edges.clear();
 	_balance.reset(nullptr);
 }
 
@@ -56,13 +59,58 @@ void vertex::set_balance(double value)
 
 void vertex::add_edge(const edge* new_edge)
 {
+	new_edge->_out_position = _edges.size();
 	_edges.push_back(new_edge);
 }
 
+void vertex::reserve_edges(const std::size_t count)
+{
+	_edges.reserve(_edges.size() + count);
+}
+
 void vertex::remove_edge(const edge* e)
 {
-	_edges.erase(std::find(std::begin(_edges), std::end(_edges), e));
-	return;
+	assert(_edges[e->_out_position] == e);
+
+	// Move the last edge into the free position
+	const edge* last_edge = _edges.back();
+
+	last_edge->_out_position = e->_out_position;
+	_edges[e->_out_position] = last_edge;
+	_edges.pop_back();
+}
+
+void vertex::add_pointing_edge(const edge* new_edge)
+{
+	new_edge->_in_position = _pointing_edges.size();
+	_pointing_edges.push_back(new_edge);
+}
+
+void vertex::reserve_pointing_edges(const std::size_t count)
+{
+	_pointing_edges.reserve(_pointing_edges.size() + count);
+}
+
+void vertex::remove_pointing_edge(const edge* e)
+{
+	assert(_pointing_edges[e->_in_position] == e);
+
+	// Move the last edge into the free position
+	const edge* last_edge = _pointing_edges.back();
+
+	last_edge->_in_position = e->_in_position;
+	_pointing_edges[e->_in_position] = last_edge;
+	_pointing_edges.pop_back();
+}
+
+std::size_t vertex::get_out_degree(void) const
+{
+	return _edges.size();
+}
+
+std::size_t vertex::get_in_degree(void) const
+{
+	return _pointing_edges.size();
 }
 
 std::shared_ptr<vertex> vertex::create_copy(void) const
@@ -0,0 +1,219 @@
+#include <graph_xml_parser.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace graph
+{
+
+namespace
+{
+
+bool is_whitespace(const char c)
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool is_name_end(const char c)
+{
+	return is_whitespace(c) || c == '>' || c == '/' || c == '=';
+}
+
+}
+
+//------------------------------------------------------------------------------
+
+xml_handler::~xml_handler()
+{
+}
+
+std::string_view xml_handler::find_attribute(
+	const std::vector<xml_attribute>& attributes,
+	const std::string_view& name)
+{
+	for(const xml_attribute& attribute : attributes)
+	{
+		if(attribute.name == name)
+			return attribute.value;
+	}
+
+	return std::string_view();
+}
+
+std::string_view xml_handler::local_name(const std::string_view& name)
+{
+	const std::size_t colon = name.find(':');
+
+	if(colon == std::string_view::npos)
+		return name;
+
+	return name.substr(colon + 1);
+}
+
+//------------------------------------------------------------------------------
+
+xml_parser::xml_parser(const char* begin, const char* end)
+	:
+	_position(begin),
+	_end(end)
+{
+}
+
+xml_parser::~xml_parser()
+{
+}
+
+bool xml_parser::parse(xml_handler* handler)
+{
+	while(_position != _end)
+	{
+		const char* tag = std::find(_position, _end, '<');
+
+		if(tag != _position)
+			handler->characters(std::string_view(_position, tag - _position));
+
+		_position = tag;
+
+		if(_position == _end)
+			break;
+
+		if(!parse_tag(handler))
+			return false;
+	}
+
+	return true;
+}
+
+bool xml_parser::parse_tag(xml_handler* handler)
+{
+	const std::string_view rest(_position, _end - _position);
+
+	// <?xml ...?> and other processing instructions
+	if(rest.compare(0, 2, "<?") == 0)
+		return skip_until("?>");
+
+	if(rest.compare(0, 4, "<!--") == 0)
+		return skip_until("-->");
+
+	if(rest.compare(0, 9, "<![CDATA[") == 0)
+	{
+		const char* text = _position + 9;
+
+		if(!skip_until("]]>"))
+			return false;
+
+		handler->characters(std::string_view(text, _position - 3 - text));
+		return true;
+	}
+
+	// <!DOCTYPE ...> (internal subsets are not supported)
+	if(rest.compare(0, 2, "<!") == 0)
+		return skip_until(">");
+
+	// End tag
+	if(rest.compare(0, 2, "</") == 0)
+	{
+		_position += 2;
+
+		const std::string_view name = read_name();
+
+		skip_whitespace();
+		if(name.empty() || _position == _end || *_position != '>')
+			return false;
+
+		++_position;
+		handler->end_element(name);
+		return true;
+	}
+
+	// Start tag or empty element
+	++_position;
+
+	const std::string_view name = read_name();
+
+	if(name.empty())
+		return false;
+
+	_attributes.clear();
+
+	while(true)
+	{
+		skip_whitespace();
+
+		if(_position == _end)
+			return false;
+
+		if(*_position == '>')
+		{
+			++_position;
+			handler->start_element(name, _attributes);
+			return true;
+		}
+
+		if(*_position == '/')
+		{
+			if(_end - _position < 2 || _position[1] != '>')
+				return false;
+
+			_position += 2;
+			handler->start_element(name, _attributes);
+			handler->end_element(name);
+			return true;
+		}
+
+		xml_attribute attribute;
+
+		attribute.name = read_name();
+		skip_whitespace();
+
+		if(attribute.name.empty() || _position == _end || *_position != '=')
+			return false;
+
+		++_position;
+		skip_whitespace();
+
+		if(_position == _end || (*_position != '"' && *_position != '\''))
+			return false;
+
+		const char quote = *_position++;
+		const char* value_end = std::find(_position, _end, quote);
+
+		if(value_end == _end)
+			return false;
+
+		attribute.value = std::string_view(_position, value_end - _position);
+		_attributes.push_back(attribute);
+
+		_position = value_end + 1;
+	}
+}
+
+bool xml_parser::skip_until(const std::string_view& terminator)
+{
+	const char* found = std::search(
+		_position, _end, terminator.begin(), terminator.end());
+
+	if(found == _end)
+		return false;
+
+	_position = found + terminator.size();
+	return true;
+}
+
+void xml_parser::skip_whitespace(void)
+{
+	while(_position != _end && is_whitespace(*_position))
+		++_position;
+}
+
+std::string_view xml_parser::read_name(void)
+{
+	const char* begin = _position;
+
+	while(_position != _end && !is_name_end(*_position))
+		++_position;
+
+	return std::string_view(begin, _position - begin);
+}
+
+}
@@ -11,6 +11,7 @@
 
 #include <graph.h>
 #include <graph_loader.h>
+#include <graph_exporter.h>
 #include <graph_algorithm.h>
 #include <graph_edge.h>
 #include <graph_vertex.h>
@@ -119,20 +120,8 @@ void practical_training::task00_debugging(void)
 //	std::cout << ld.file_name_get(file) << std::endl << std::endl;
 //	ld.load(file, g);
 
-//	std::fstream out("Kostenminimal3.tgf", std::ios::out | std::ios::trunc);
-
-//	for(const graph::vertex* v : g.get_vertices())
-//	{
-//		out << v->get_id() << "\t" << v->get_id() << "/" << v->get_balance() << std::endl;
-//	}
-//	out << "#" << std::endl;
-
-//	for(const graph::edge* e : g.get_edges())
-//	{
-//		out << e->get_source()->get_id() << "\t" << e->get_target()->get_id() << "\t";
-//		out << e->get_capacity() << "/" << e->get_cost() << std::endl;
-//	}
-//	out.close();
+//	graph::exporter ex;
+//	ex.save_tgf("Kostenminimal3.tgf", g);
 
 
 //	// Check if double edges between vertices exist.
@@ -0,0 +1,882 @@
+#include <gtest/gtest.h>
+#include <graph.h>
+#include <graph_bit_matrix_graph.h>
+#include <graph_csr_graph.h>
+#include <graph_compressed_graph.h>
+#include <graph_edge_source.h>
+#include <graph_generator.h>
+#include <graph_loader.h>
+#include <graph_thread_pool.h>
+#include <graph_algorithm.h>
+#include <graph_vertex.h>
+#include <graph_edge.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+
+namespace
+{
+
+//
+// Check that a predecessor array describes a breadth first search tree:
+// every reached vertex is one level below its predecessor, the levels are
+// those of breadth_first_search.
+//
+void expect_bfs_tree(
+	const graph::csr_graph& csr,
+	const std::uint32_t start_index,
+	const std::vector<std::uint32_t>& predecessor)
+{
+	graph::algorithm ga;
+	std::vector<std::uint32_t> reference, order, level(csr.get_vertex_count(), 0);
+
+	ga.breadth_first_search(&csr, start_index, &reference);
+	ASSERT_EQ(predecessor.size(), reference.size());
+
+	// Levels of the reference tree, a vertex follows its predecessor in the
+	// queue order, so resolve them by repeated passes.
+	bool changed = true;
+	while(changed)
+	{
+		changed = false;
+		for(std::uint32_t i = 0; i < reference.size(); ++i)
+		{
+			if(reference[i] != graph::csr_graph::invalid_index &&
+				level[i] != level[reference[i]] + 1)
+			{
+				level[i] = level[reference[i]] + 1;
+				changed = true;
+			}
+		}
+	}
+
+	for(std::uint32_t i = 0; i < predecessor.size(); ++i)
+	{
+		ASSERT_EQ(
+			predecessor[i] == graph::csr_graph::invalid_index,
+			reference[i] == graph::csr_graph::invalid_index);
+
+		if(predecessor[i] == graph::csr_graph::invalid_index)
+			continue;
+
+		const std::uint32_t* targets = csr.get_targets();
+
+		EXPECT_EQ(level[predecessor[i]] + 1, level[i]);
+		EXPECT_NE(std::find(
+			targets + csr.get_edge_begin(predecessor[i]),
+			targets + csr.get_edge_end(predecessor[i]), i),
+			targets + csr.get_edge_end(predecessor[i]));
+	}
+}
+
+}
+
+TEST(graph_csr_graph, create_from_graph)
+{
+	graph::graph gg;
+
+	gg.add_directed_edge(0, 1, 2.0);
+	gg.add_directed_edge(0, 2, 3.0);
+	gg.add_directed_edge(2, 1, 4.0);
+	gg.add_vertex(5);
+
+	graph::csr_graph csr(&gg);
+
+	EXPECT_EQ(csr.get_vertex_count(), 4);
+	EXPECT_EQ(csr.get_edge_count(), 3);
+	EXPECT_TRUE(csr.has_weights());
+	EXPECT_FALSE(csr.has_costs());
+
+	EXPECT_EQ(csr.get_index(5), 3);
+	EXPECT_EQ(csr.get_id(3), 5);
+	EXPECT_EQ(csr.get_index(4), graph::csr_graph::invalid_index);
+
+	EXPECT_EQ(csr.get_degree(0), 2);
+	EXPECT_EQ(csr.get_degree(1), 0);
+	EXPECT_EQ(csr.get_degree(3), 0);
+
+	const std::uint32_t e = csr.get_edge_begin(2);
+	EXPECT_EQ(csr.get_target(e), 1);
+	EXPECT_EQ(csr.get_weight(e), 4.0);
+}
+
+TEST(graph_algorithm_csr, breadth_first_search_graph2)
+{
+	graph::graph gg, gg_bfs;
+	graph::loader gl;
+	graph::algorithm ga;
+	std::vector<std::uint32_t> predecessor;
+
+	gl.load(graph::files::Graph2, gg);
+	graph::csr_graph csr(&gg);
+
+	ga.breadth_first_search(&gg, gg.get_vertex(0), &gg_bfs);
+	ga.breadth_first_search(&csr, csr.get_index(0), &predecessor);
+
+	// Every vertex of the spanning tree except the start has a predecessor.
+	std::uint32_t reached = 0;
+	for(std::uint32_t p : predecessor)
+		reached += (p != graph::csr_graph::invalid_index) ? 1 : 0;
+
+	EXPECT_EQ(reached + 1, gg_bfs.get_vertex_count());
+}
+
+TEST(graph_csr_graph, transpose)
+{
+	graph::graph gg;
+	graph::loader gl;
+
+	gl.load(graph::files::Wege1, gg, true);
+
+	const graph::csr_graph csr(&gg);
+	graph::csr_graph transpose, transpose_twice;
+
+	csr.create_transpose(&transpose);
+	transpose.create_transpose(&transpose_twice);
+
+	ASSERT_EQ(transpose.get_vertex_count(), csr.get_vertex_count());
+	ASSERT_EQ(transpose.get_edge_count(), csr.get_edge_count());
+	EXPECT_TRUE(transpose.has_weights());
+
+	for(const graph::vertex* v : gg.get_vertices())
+	{
+		const std::uint32_t index = transpose.get_index(v->get_id());
+
+		EXPECT_EQ(transpose.get_degree(index), v->get_in_degree());
+
+		for(std::uint32_t e = transpose.get_edge_begin(index); e < transpose.get_edge_end(index); ++e)
+		{
+			const graph::edge* original = gg.get_edge(
+				gg.get_vertex(transpose.get_id(transpose.get_target(e))), v);
+
+			ASSERT_NE(original, nullptr);
+			EXPECT_EQ(transpose.get_weight(e), original->get_weight());
+		}
+	}
+
+	// Reversing twice restores the edges of every vertex.
+	for(std::uint32_t i = 0; i < csr.get_vertex_count(); ++i)
+	{
+		std::vector<std::uint32_t> targets, targets_twice;
+
+		for(std::uint32_t e = csr.get_edge_begin(i); e < csr.get_edge_end(i); ++e)
+			targets.push_back(csr.get_target(e));
+		for(std::uint32_t e = transpose_twice.get_edge_begin(i); e < transpose_twice.get_edge_end(i); ++e)
+			targets_twice.push_back(transpose_twice.get_target(e));
+
+		std::sort(targets.begin(), targets.end());
+		std::sort(targets_twice.begin(), targets_twice.end());
+		EXPECT_EQ(targets, targets_twice);
+	}
+}
+
+TEST(graph_algorithm_csr, direction_optimizing_bfs_g_10_200)
+{
+	graph::graph gg;
+	graph::loader gl;
+	graph::algorithm ga;
+	std::vector<std::uint32_t> predecessor;
+
+	gl.load(graph::files::G_10_200, gg);
+
+	const graph::csr_graph csr(&gg);
+
+	ga.direction_optimizing_bfs(&csr, nullptr, 0, &predecessor);
+	expect_bfs_tree(csr, 0, predecessor);
+}
+
+TEST(graph_algorithm_csr, direction_optimizing_bfs_directed_rmat)
+{
+	graph::graph gg;
+	graph::algorithm ga;
+	graph::csr_graph transpose;
+	std::vector<std::uint32_t> predecessor;
+
+	graph::generator::rmat(12, 40000, 7).build(gg);
+
+	const graph::csr_graph csr(&gg);
+	csr.create_transpose(&transpose);
+
+	// Start at the vertex with the most outgoing edges, so the frontier
+	// grows large enough for bottom-up steps.
+	std::uint32_t start_index = 0;
+	for(std::uint32_t i = 0; i < csr.get_vertex_count(); ++i)
+	{
+		if(csr.get_degree(i) > csr.get_degree(start_index))
+			start_index = i;
+	}
+
+	ga.direction_optimizing_bfs(&csr, &transpose, start_index, &predecessor);
+	expect_bfs_tree(csr, start_index, predecessor);
+}
+
+TEST(graph_algorithm_csr, parallel_breadth_first_search)
+{
+	graph::graph gg;
+	graph::algorithm ga;
+	std::vector<std::uint32_t> predecessor;
+
+	graph::generator::rmat(14, 200000, 11).build(gg);
+
+	const graph::csr_graph csr(&gg);
+
+	for(const std::size_t thread_count : { 1, 4 })
+	{
+		ga.set_thread_count(thread_count);
+		ga.parallel_breadth_first_search(&csr, 0, &predecessor);
+		expect_bfs_tree(csr, 0, predecessor);
+	}
+}
+
+TEST(graph_algorithm_csr, parallel_connected_component_with_bfs)
+{
+	graph::algorithm ga;
+
+	for(const graph::files file : { graph::files::G_1_2, graph::files::G_10_200 })
+	{
+		graph::graph gg;
+		graph::loader gl;
+
+		gl.load(file, gg);
+
+		const graph::csr_graph csr(&gg);
+		std::unique_ptr<graph::edge_source> edges = gl.open_edge_source(file);
+		const graph::compressed_graph compressed(edges.get());
+		std::vector<std::uint32_t> component, compressed_component;
+		std::uint32_t component_count = 0, compressed_component_count = 0;
+
+		ga.set_thread_count(4);
+		ga.parallel_connected_component_with_bfs(&csr, &component, &component_count);
+		ga.connected_component_with_bfs(
+			&compressed, &compressed_component, &compressed_component_count);
+
+		// Both number the components in the order of their smallest index.
+		EXPECT_EQ(component_count, compressed_component_count);
+		EXPECT_EQ(component, compressed_component);
+	}
+}
+
+TEST(graph_algorithm_csr, depth_first_search_timestamps_g_1_200)
+{
+	graph::graph gg, gg_dfs;
+	graph::loader gl;
+	graph::algorithm ga;
+	std::vector<std::uint32_t> predecessor, pre_order, post_order;
+
+	gl.load(graph::files::G_1_200, gg);
+
+	const graph::csr_graph csr(&gg);
+
+	ga.depth_first_search(&gg, gg.get_vertex(0), &gg_dfs);
+	ga.depth_first_search(&csr, 0, &predecessor, &pre_order, &post_order);
+
+	// Same tree as the search on graph, the csr keeps the edge order.
+	std::uint32_t reached = 0;
+	for(std::uint32_t i = 0; i < csr.get_vertex_count(); ++i)
+	{
+		if(pre_order[i] == graph::csr_graph::invalid_index)
+		{
+			EXPECT_EQ(post_order[i], graph::csr_graph::invalid_index);
+			continue;
+		}
+
+		++reached;
+		EXPECT_LT(pre_order[i], post_order[i]);
+		EXPECT_LT(post_order[i], 2 * gg_dfs.get_vertex_count());
+
+		if(i == 0)
+			continue;
+
+		// The predecessor encloses the interval of its child.
+		const std::uint32_t p = predecessor[i];
+
+		ASSERT_NE(p, graph::csr_graph::invalid_index);
+		EXPECT_LT(pre_order[p], pre_order[i]);
+		EXPECT_LT(post_order[i], post_order[p]);
+		EXPECT_NE(gg_dfs.get_edge(
+			gg_dfs.get_vertex(csr.get_id(p)), gg_dfs.get_vertex(csr.get_id(i))), nullptr);
+	}
+
+	EXPECT_EQ(reached, gg_dfs.get_vertex_count());
+}
+
+TEST(graph_algorithm, depth_first_search_long_path)
+{
+	// A path this long overflowed the call stack of the recursive search.
+	const std::uint32_t vertex_count = 500000;
+
+	graph::graph gg, gg_dfs;
+	graph::algorithm ga;
+	std::vector<graph::graph::edge_record> records;
+	std::vector<std::uint32_t> predecessor, post_order;
+
+	for(std::uint32_t i = 0; i + 1 < vertex_count; ++i)
+		records.push_back({ i, i + 1 });
+	gg.add_edges(records, vertex_count, false);
+
+	ga.depth_first_search(&gg, gg.get_vertex(0), &gg_dfs);
+	EXPECT_EQ(gg_dfs.get_vertex_count(), vertex_count);
+
+	const graph::csr_graph csr(&gg);
+
+	ga.depth_first_search(&csr, 0, &predecessor, nullptr, &post_order);
+	EXPECT_EQ(predecessor[vertex_count - 1], vertex_count - 2);
+	EXPECT_EQ(post_order[0], 2 * vertex_count - 1);
+	EXPECT_EQ(post_order[vertex_count - 1], vertex_count);
+}
+
+TEST(graph_algorithm_csr, connected_component_with_afforest)
+{
+	graph::algorithm ga;
+	std::vector<graph::generator> generators;
+
+	// A giant component with small ones, and a graph of many small ones.
+	generators.push_back(graph::generator::erdos_renyi(20000, 30000, 5));
+	generators.push_back(graph::generator::erdos_renyi(20000, 6000, 5));
+	generators.push_back(graph::generator::grid(100, 100, 5));
+
+	for(graph::generator& generator : generators)
+	{
+		graph::graph gg;
+
+		generator.build(gg);
+
+		const graph::csr_graph csr(&gg);
+		std::vector<std::uint32_t> component, component_bfs;
+		std::uint32_t component_count = 0, component_count_bfs = 0;
+
+		ga.set_thread_count(1);
+		ga.parallel_connected_component_with_bfs(&csr, &component_bfs, &component_count_bfs);
+
+		for(const std::size_t thread_count : { 1, 4 })
+		{
+			ga.set_thread_count(thread_count);
+			ga.connected_component_with_afforest(&csr, &component, &component_count);
+
+			EXPECT_EQ(component_count, component_count_bfs);
+			EXPECT_EQ(component, component_bfs);
+		}
+	}
+
+	// Empty graph
+	const graph::csr_graph csr;
+	std::vector<std::uint32_t> component;
+	std::uint32_t component_count = 1;
+
+	ga.connected_component_with_afforest(&csr, &component, &component_count);
+	EXPECT_TRUE(component.empty());
+	EXPECT_EQ(component_count, 0);
+}
+
+TEST(graph_algorithm_csr, shared_thread_pool)
+{
+	graph::thread_pool pool(4);
+	graph::loader gl;
+	graph::algorithm ga, ga_serial;
+
+	gl.set_thread_pool(&pool);
+	ga.set_thread_pool(&pool);
+	ga_serial.set_thread_count(1);
+
+	// Small inputs are processed by the calling thread alone.
+	graph::graph small_graph;
+	gl.load(graph::files::G_1_2, small_graph);
+
+	const graph::csr_graph small_csr(&small_graph);
+	std::vector<std::uint32_t> predecessor, component, component_serial;
+	std::uint32_t component_count = 0, component_count_serial = 0;
+
+	ga.parallel_breadth_first_search(&small_csr, 0, &predecessor);
+	expect_bfs_tree(small_csr, 0, predecessor);
+	ga.connected_component_with_afforest(&small_csr, &component, &component_count);
+	ga_serial.connected_component_with_afforest(
+		&small_csr, &component_serial, &component_count_serial);
+
+	EXPECT_EQ(component, component_serial);
+	EXPECT_EQ(pool.get_started_thread_count(), 1);
+
+	// A large file starts the workers, the algorithms reuse them.
+	graph::graph large_graph;
+	gl.load(graph::files::G_10_200, large_graph);
+
+	EXPECT_EQ(pool.get_started_thread_count(), 4);
+
+	const graph::csr_graph large_csr(&large_graph);
+
+	for(int round = 0; round < 3; ++round)
+	{
+		ga.connected_component_with_afforest(&large_csr, &component, &component_count);
+		ga_serial.connected_component_with_afforest(
+			&large_csr, &component_serial, &component_count_serial);
+
+		EXPECT_EQ(component_count, component_count_serial);
+		EXPECT_EQ(component, component_serial);
+	}
+
+	EXPECT_EQ(pool.get_started_thread_count(), 4);
+}
+
+TEST(graph_algorithm, direction_optimizing_bfs_spanning_tree)
+{
+	graph::graph gg, gg_bfs, gg_tree;
+	graph::loader gl;
+	graph::algorithm ga;
+
+	gl.load(graph::files::Graph2, gg);
+
+	ga.breadth_first_search(&gg, gg.get_vertex(0), &gg_bfs);
+	ga.direction_optimizing_bfs(&gg, gg.get_vertex(0), &gg_tree);
+
+	EXPECT_EQ(gg_tree.get_vertex_count(), gg_bfs.get_vertex_count());
+	EXPECT_EQ(gg_tree.get_edge_count(), gg_bfs.get_edge_count());
+}
+
+TEST(graph_algorithm, direction_optimizing_bfs_parallel_edges)
+{
+	graph::algorithm ga;
+
+	// Two parallel arcs
+	{
+		graph::graph gg, gg_tree;
+
+		gg.add_directed_edge(0, 1, 1.0);
+		gg.add_directed_edge(0, 1, 2.0);
+		gg.add_directed_edge(1, 2, 3.0);
+
+		ga.direction_optimizing_bfs(&gg, gg.get_vertex(0), &gg_tree);
+
+		EXPECT_EQ(gg_tree.get_vertex_count(), 3);
+		EXPECT_EQ(gg_tree.get_edge_count(), 2);
+	}
+
+	// Two parallel undirected edges, the small graph is searched bottom-up.
+	{
+		graph::graph gg, gg_tree;
+
+		gg.add_undirected_edge(0, 1, 1.0);
+		gg.add_undirected_edge(0, 1, 2.0);
+		gg.add_undirected_edge(1, 2, 3.0);
+
+		ga.direction_optimizing_bfs(&gg, gg.get_vertex(0), &gg_tree);
+
+		EXPECT_EQ(gg_tree.get_vertex_count(), 3);
+		EXPECT_EQ(gg_tree.get_edge_count(), 4);
+	}
+
+	// R-MAT keeps loops and parallel edges, start at the vertex with the
+	// most outgoing edges, so bottom-up steps are taken.
+	graph::graph gg, gg_tree;
+
+	graph::generator::rmat(10, 16000, 1).build(gg);
+
+	const graph::csr_graph csr(&gg);
+	std::vector<std::uint32_t> predecessor;
+	std::uint32_t start_index = 0;
+
+	for(std::uint32_t i = 0; i < csr.get_vertex_count(); ++i)
+	{
+		if(csr.get_degree(i) > csr.get_degree(start_index))
+			start_index = i;
+	}
+
+	ga.breadth_first_search(&csr, start_index, &predecessor);
+	ga.direction_optimizing_bfs(&gg, gg.get_vertex(csr.get_id(start_index)), &gg_tree);
+
+	const std::size_t discovered = predecessor.size() - std::count(
+		predecessor.begin(), predecessor.end(), graph::csr_graph::invalid_index);
+
+	// Every reached vertex except the start has its discovering edge.
+	ASSERT_GT(discovered, 100);
+	EXPECT_EQ(gg_tree.get_vertex_count(), discovered + 1);
+	EXPECT_EQ(gg_tree.get_edge_count(), discovered);
+
+	for(const graph::edge* e : gg_tree.get_edges())
+	{
+		EXPECT_NE(e->get_target()->get_id(), csr.get_id(start_index));
+		EXPECT_EQ(e->get_target()->get_in_degree(), 1);
+	}
+}
+
+TEST(graph_algorithm_csr, prim_and_dijkstra_g_1_2)
+{
+	graph::graph gg, gg_mst;
+	graph::loader gl;
+	graph::algorithm ga;
+	double cost_graph = 0.0, cost_csr = 0.0;
+	std::vector<std::uint32_t> predecessor;
+	std::vector<double> distances;
+	bool negative_weights_found = true;
+
+	gl.load(graph::files::G_1_2, gg);
+	graph::csr_graph csr(&gg);
+
+	ga.prim(&gg, gg.get_vertex(0), &gg_mst, &cost_graph);
+	ga.prim(&csr, csr.get_index(0), &predecessor, &cost_csr);
+
+	EXPECT_NEAR(cost_graph, cost_csr, 0.00001);
+
+	ga.dijkstra(
+		&csr, csr.get_index(0), &predecessor, &distances, &negative_weights_found);
+
+	EXPECT_NEAR(distances[csr.get_index(1)], 2.36796, 0.00001);
+	EXPECT_FALSE(negative_weights_found);
+}
+
+TEST(graph_algorithm_csr, moore_bellman_ford_wege)
+{
+	std::vector<std::uint32_t> predecessor;
+	std::vector<double> distances;
+	bool negative_cycle_found = false;
+	graph::loader gl;
+	graph::algorithm ga;
+
+	graph::graph gg1;
+	gl.load(graph::files::Wege1, gg1, true);
+	graph::csr_graph csr1(&gg1);
+
+	ga.moore_bellman_ford(
+		&csr1, csr1.get_index(2), &predecessor, &distances, &negative_cycle_found);
+
+	EXPECT_EQ(distances[csr1.get_index(0)], 6);
+	EXPECT_FALSE(negative_cycle_found);
+
+	graph::graph gg3;
+	gl.load(graph::files::Wege3, gg3, true);
+	graph::csr_graph csr3(&gg3);
+
+	ga.moore_bellman_ford(
+		&csr3, csr3.get_index(2), &predecessor, &distances, &negative_cycle_found);
+
+	EXPECT_TRUE(negative_cycle_found);
+}
+
+TEST(graph_csr_graph, snapshot)
+{
+	const std::string file_name = "csr_graph_snapshot_test.bin";
+	graph::graph gg;
+	graph::loader gl;
+	graph::algorithm ga;
+	graph::csr_graph snapshot;
+	std::vector<std::uint32_t> predecessor;
+	std::vector<double> distances_csr, distances_snapshot;
+	bool negative_weights_found = true;
+
+	gl.load(graph::files::G_1_2, gg);
+	graph::csr_graph csr(&gg);
+
+	ASSERT_TRUE(gl.save_snapshot(file_name, gg));
+	ASSERT_TRUE(gl.load_snapshot(file_name, &snapshot));
+
+	EXPECT_EQ(snapshot.get_vertex_count(), csr.get_vertex_count());
+	EXPECT_EQ(snapshot.get_edge_count(), csr.get_edge_count());
+	EXPECT_TRUE(snapshot.has_weights());
+	EXPECT_FALSE(snapshot.has_costs());
+	EXPECT_FALSE(snapshot.has_balances());
+
+	for(std::uint32_t i = 0; i < csr.get_vertex_count(); ++i)
+	{
+		ASSERT_EQ(snapshot.get_id(i), csr.get_id(i));
+		ASSERT_EQ(snapshot.get_edge_begin(i), csr.get_edge_begin(i));
+	}
+
+	ga.dijkstra(
+		&csr, 0, &predecessor, &distances_csr, &negative_weights_found);
+	ga.dijkstra(
+		&snapshot, 0, &predecessor, &distances_snapshot, &negative_weights_found);
+
+	EXPECT_EQ(distances_csr, distances_snapshot);
+
+	// Copies share the mapped file, it stays valid without the original.
+	graph::csr_graph copy(snapshot);
+	snapshot = graph::csr_graph();
+
+	EXPECT_EQ(snapshot.get_vertex_count(), 0);
+	EXPECT_EQ(copy.get_target(copy.get_edge_begin(0)), csr.get_target(csr.get_edge_begin(0)));
+
+	std::remove(file_name.c_str());
+}
+
+TEST(graph_csr_graph, snapshot_with_balances_and_invalid_files)
+{
+	const std::string file_name = "csr_graph_snapshot_test.bin";
+	graph::graph gg;
+	graph::loader gl;
+	graph::csr_graph snapshot;
+
+	gl.load(graph::files::Kostenminimal1, gg);
+	graph::csr_graph csr(&gg);
+
+	ASSERT_TRUE(gl.save_snapshot(file_name, gg));
+	ASSERT_TRUE(gl.load_snapshot(file_name, &snapshot));
+
+	ASSERT_TRUE(snapshot.has_balances());
+	ASSERT_TRUE(snapshot.has_costs());
+	ASSERT_TRUE(snapshot.has_capacities());
+
+	for(std::uint32_t i = 0; i < csr.get_vertex_count(); ++i)
+		EXPECT_EQ(snapshot.get_balance(i), csr.get_balance(i));
+	for(std::uint32_t e = 0; e < csr.get_edge_count(); ++e)
+	{
+		EXPECT_EQ(snapshot.get_cost(e), csr.get_cost(e));
+		EXPECT_EQ(snapshot.get_capacity(e), csr.get_capacity(e));
+	}
+
+	// A text file and a truncated snapshot are rejected.
+	EXPECT_FALSE(gl.load_snapshot("../graph/Graph2.txt", &snapshot));
+	EXPECT_FALSE(gl.load_snapshot("does_not_exist.bin", &snapshot));
+
+	// Corrupted arrays of the right size are rejected: header (40 bytes),
+	// ids, offsets and targets, each padded to 8 bytes.
+	const std::size_t n = csr.get_vertex_count();
+	const std::size_t id_position = 40;
+	const std::size_t offset_position = id_position + (n * 4 + 7) / 8 * 8;
+	const std::size_t target_position = offset_position + ((n + 1) * 4 + 7) / 8 * 8;
+	const std::string valid_file = [&]()
+	{
+		std::ifstream fs(file_name, std::ios::binary);
+		return std::string(std::istreambuf_iterator<char>(fs), std::istreambuf_iterator<char>());
+	}();
+	const auto write_corrupted = [&](const std::size_t position, const std::uint32_t value)
+	{
+		std::string corrupted = valid_file;
+
+		std::memcpy(&corrupted[position], &value, sizeof(value));
+		std::ofstream(file_name, std::ios::binary) << corrupted;
+	};
+
+	write_corrupted(target_position, 0x7fffffff);
+	EXPECT_FALSE(gl.load_snapshot(file_name, &snapshot));
+	write_corrupted(offset_position, 1);
+	EXPECT_FALSE(gl.load_snapshot(file_name, &snapshot));
+	write_corrupted(offset_position + 4, csr.get_edge_count() + 1);
+	EXPECT_FALSE(gl.load_snapshot(file_name, &snapshot));
+	write_corrupted(id_position, csr.get_id(1));
+	EXPECT_FALSE(gl.load_snapshot(file_name, &snapshot));
+
+	// Unknown attribute flag
+	std::uint32_t attributes = 0;
+
+	std::memcpy(&attributes, &valid_file[16], sizeof(attributes));
+	write_corrupted(16, attributes | 1 << 4);
+	EXPECT_FALSE(gl.load_snapshot(file_name, &snapshot));
+
+	write_corrupted(target_position, 0);
+	ASSERT_TRUE(gl.load_snapshot(file_name, &snapshot));
+
+	std::ofstream(file_name.c_str(), std::ios::binary | std::ios::app) << 'x';
+	EXPECT_FALSE(gl.load_snapshot(file_name, &snapshot));
+
+	// The last mapped snapshot is still usable.
+	EXPECT_EQ(snapshot.get_vertex_count(), csr.get_vertex_count());
+
+	std::remove(file_name.c_str());
+}
+
+TEST(graph_compressed_graph, neighbors_match_csr)
+{
+	graph::graph gg;
+
+	// Neighbors below the vertex, gaps of one and several bytes
+	gg.add_directed_edge(5, 0, 1.0);
+	gg.add_directed_edge(5, 300000, 1.0);
+	gg.add_directed_edge(5, 6, 1.0);
+	gg.add_directed_edge(5, 6, 2.0);
+	gg.add_directed_edge(0, 5, 1.0);
+
+	const graph::csr_graph csr(&gg);
+	const graph::compressed_graph compressed(&csr);
+
+	ASSERT_EQ(compressed.get_vertex_count(), csr.get_vertex_count());
+	ASSERT_EQ(compressed.get_edge_count(), csr.get_edge_count());
+
+	for(std::uint32_t i = 0; i < csr.get_vertex_count(); ++i)
+	{
+		std::vector<std::uint32_t> expected(
+			csr.get_targets() + csr.get_edge_begin(i), csr.get_targets() + csr.get_edge_end(i));
+		std::vector<std::uint32_t> decoded;
+
+		std::sort(expected.begin(), expected.end());
+		for(const std::uint32_t target : compressed.get_neighbors(i))
+			decoded.push_back(target);
+
+		EXPECT_EQ(decoded, expected);
+		EXPECT_EQ(compressed.get_degree(i), expected.size());
+	}
+}
+
+TEST(graph_algorithm_compressed, bfs_and_components_g_10_200)
+{
+	graph::graph gg;
+	graph::loader gl;
+	graph::algorithm ga;
+
+	gl.load(graph::files::G_10_200, gg);
+
+	const graph::csr_graph csr(&gg);
+	std::unique_ptr<graph::edge_source> edges = gl.open_edge_source(graph::files::G_10_200);
+	const graph::compressed_graph compressed(edges.get());
+
+	ASSERT_TRUE(compressed.is_valid());
+	ASSERT_EQ(compressed.get_vertex_count(), gg.get_vertex_count());
+	ASSERT_EQ(compressed.get_edge_count(), gg.get_edge_count());
+
+	// A missing file gives an empty, invalid graph.
+	graph::file_edge_source missing(
+		"../graph/does_not_exist.txt", graph::edge_format::edge_list);
+	const graph::compressed_graph compressed_missing(&missing);
+
+	EXPECT_FALSE(compressed_missing.is_valid());
+	EXPECT_EQ(compressed_missing.get_vertex_count(), 0);
+	EXPECT_EQ(compressed_missing.get_edge_count(), 0);
+
+	// The gaps need less than the 4 bytes per edge of the csr targets.
+	EXPECT_LT(compressed.get_memory_size(), csr.get_edge_count() * sizeof(std::uint32_t));
+
+	// Ids are dense, so csr index and compressed index are the same.
+	std::vector<std::uint32_t> csr_predecessor, compressed_predecessor;
+
+	ga.breadth_first_search(&csr, 0, &csr_predecessor);
+	ga.breadth_first_search(&compressed, 0, &compressed_predecessor);
+
+	ASSERT_EQ(csr_predecessor.size(), compressed_predecessor.size());
+	for(std::size_t i = 0; i < csr_predecessor.size(); ++i)
+	{
+		EXPECT_EQ(
+			csr_predecessor[i] == graph::csr_graph::invalid_index,
+			compressed_predecessor[i] == graph::compressed_graph::invalid_index);
+	}
+
+	std::vector<std::shared_ptr<graph::graph>> subgraphs;
+	std::vector<std::uint32_t> component;
+	std::uint32_t component_count = 0;
+
+	ga.connected_component_with_bfs(&gg, &subgraphs);
+	ga.connected_component_with_bfs(&compressed, &component, &component_count);
+
+	EXPECT_EQ(component_count, subgraphs.size());
+	EXPECT_EQ(component[0], 0);
+}
+
+TEST(graph_bit_matrix_graph, words_and_components)
+{
+	graph::algorithm ga;
+
+	// Three words per row, the last one only partly used.
+	graph::bit_matrix_graph bits(130);
+
+	bits.set_edge(0, 64);
+	bits.set_edge(64, 0);
+	bits.set_edge(0, 129);
+	bits.set_edge(129, 0);
+	bits.set_edge(64, 129);
+	bits.set_edge(129, 64);
+	bits.set_edge(5, 6);
+	bits.set_edge(6, 5);
+
+	EXPECT_EQ(bits.get_word_count(), 3);
+	EXPECT_EQ(bits.get_edge_count(), 8);
+	EXPECT_TRUE(bits.has_edge(0, 129));
+	EXPECT_FALSE(bits.has_edge(0, 128));
+	EXPECT_EQ(bits.get_degree(0), 2);
+	EXPECT_EQ(bits.get_common_neighbor_count(0, 64), 1);
+	EXPECT_EQ(bits.get_common_neighbor_count(0, 5), 0);
+
+	std::vector<std::uint32_t> component;
+	std::uint32_t component_count = 0;
+
+	ga.connected_component_with_bfs(&bits, &component, &component_count);
+
+	// {0, 64, 129}, {5, 6} and 125 isolated vertices
+	EXPECT_EQ(component_count, 127);
+	EXPECT_EQ(component[64], component[0]);
+	EXPECT_EQ(component[129], component[0]);
+	EXPECT_EQ(component[6], component[5]);
+	EXPECT_NE(component[5], component[0]);
+
+	std::vector<std::uint32_t> predecessor;
+
+	ga.breadth_first_search(&bits, 129, &predecessor);
+	EXPECT_EQ(predecessor[0], 129);
+	EXPECT_EQ(predecessor[64], 129);
+	EXPECT_EQ(predecessor[5], graph::bit_matrix_graph::invalid_index);
+}
+
+TEST(graph_bit_matrix_graph, invalid_sources)
+{
+	const std::string file_name = "bit_matrix_graph_test.txt";
+
+	// A missing file gives an empty, invalid graph.
+	graph::file_edge_source missing(
+		"../graph/does_not_exist.txt", graph::edge_format::edge_list);
+	const graph::bit_matrix_graph bits_missing(&missing);
+
+	EXPECT_FALSE(bits_missing.is_valid());
+	EXPECT_EQ(bits_missing.get_vertex_count(), 0);
+	EXPECT_EQ(bits_missing.get_edge_count(), 0);
+
+	// So does a vertex id beyond the announced vertex count.
+	std::ofstream(file_name) << "3\n0\t1\n1\t3\n";
+
+	graph::file_edge_source out_of_range(file_name, graph::edge_format::edge_list);
+	const graph::bit_matrix_graph bits_out_of_range(&out_of_range);
+
+	EXPECT_FALSE(bits_out_of_range.is_valid());
+	EXPECT_EQ(bits_out_of_range.get_vertex_count(), 0);
+	EXPECT_EQ(bits_out_of_range.get_edge_count(), 0);
+
+	// Ids in range are accepted.
+	std::ofstream(file_name) << "3\n0\t1\n1\t2\n";
+
+	graph::file_edge_source in_range(file_name, graph::edge_format::edge_list);
+	const graph::bit_matrix_graph bits_in_range(&in_range);
+
+	EXPECT_TRUE(bits_in_range.is_valid());
+	EXPECT_EQ(bits_in_range.get_vertex_count(), 3);
+	EXPECT_EQ(bits_in_range.get_edge_count(), 4);
+
+	std::remove(file_name.c_str());
+}
+
+TEST(graph_algorithm_bit_matrix, graph1)
+{
+	graph::graph gg;
+	graph::loader gl;
+	graph::algorithm ga;
+
+	gl.load(graph::files::Graph1, gg);
+
+	std::unique_ptr<graph::edge_source> edges = gl.open_edge_source(graph::files::Graph1);
+	const graph::bit_matrix_graph bits(edges.get());
+	const graph::csr_graph csr(&gg);
+
+	ASSERT_TRUE(bits.is_valid());
+	ASSERT_EQ(bits.get_vertex_count(), gg.get_vertex_count());
+	EXPECT_EQ(bits.get_edge_count(), gg.get_edge_count());
+
+	for(std::uint32_t i = 0; i < bits.get_vertex_count(); ++i)
+		EXPECT_EQ(bits.get_degree(i), gg.get_vertex(i)->get_out_degree());
+
+	std::vector<std::uint32_t> csr_predecessor, bits_predecessor;
+
+	ga.breadth_first_search(&csr, 0, &csr_predecessor);
+	ga.breadth_first_search(&bits, 0, &bits_predecessor);
+
+	for(std::uint32_t i = 0; i < bits.get_vertex_count(); ++i)
+	{
+		EXPECT_EQ(
+			csr_predecessor[i] == graph::csr_graph::invalid_index,
+			bits_predecessor[i] == graph::bit_matrix_graph::invalid_index);
+	}
+
+	std::vector<std::shared_ptr<graph::graph>> subgraphs;
+	std::vector<std::uint32_t> component;
+	std::uint32_t component_count = 0;
+
+	ga.connected_component_with_bfs(&gg, &subgraphs);
+	ga.connected_component_with_bfs(&bits, &component, &component_count);
+
+	EXPECT_EQ(component_count, subgraphs.size());
+}
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include <graph.h>
+#include <graph_algorithm.h>
+#include <graph_disjoint_set.h>
+#include <graph_edge_source.h>
+#include <graph_loader.h>
+#include <graph_vertex.h>
+#include <graph_edge.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+
+TEST(graph_disjoint_set, unite_and_find)
+{
+	graph::disjoint_set components(4);
+
+	EXPECT_EQ(components.get_set_count(), 4);
+	EXPECT_TRUE(components.unite(0, 1));
+	EXPECT_TRUE(components.unite(2, 3));
+	EXPECT_FALSE(components.unite(1, 0));
+	EXPECT_EQ(components.get_set_count(), 2);
+	EXPECT_NE(components.find(0), components.find(2));
+
+	EXPECT_TRUE(components.unite(1, 3));
+	EXPECT_EQ(components.find(0), components.find(2));
+	EXPECT_EQ(components.get_set_size(3), 4);
+
+	// Unknown elements are added as singletons.
+	EXPECT_TRUE(components.unite(5, 0));
+	EXPECT_EQ(components.get_size(), 6);
+	EXPECT_EQ(components.get_set_count(), 2);
+	EXPECT_EQ(components.get_set_size(4), 1);
+}
+
+TEST(graph_algorithm, connected_component_with_union_find)
+{
+	for(const graph::files file : { graph::files::Graph3, graph::files::Graph4 })
+	{
+		graph::graph gg;
+		graph::loader gl;
+		graph::algorithm ga;
+		std::vector<std::shared_ptr<graph::graph>> subgraphs_bfs, subgraphs;
+		std::vector<std::uint32_t> component, component_sizes;
+
+		gl.load(file, gg);
+
+		ga.connected_component_with_bfs(&gg, &subgraphs_bfs);
+		ga.connected_component_with_union_find(&gg, &component, &component_sizes);
+
+		ASSERT_EQ(component.size(), gg.get_vertex_count());
+		ASSERT_EQ(component_sizes.size(), subgraphs_bfs.size());
+		EXPECT_EQ(component[0], 0);
+
+		// Both find the components in the order of their smallest vertex.
+		for(std::size_t i = 0; i < subgraphs_bfs.size(); ++i)
+			EXPECT_EQ(component_sizes[i], std::max<std::uint32_t>(subgraphs_bfs[i]->get_vertex_count(), 1));
+
+		ga.create_component_subgraphs(
+			&gg, component, static_cast<std::uint32_t>(component_sizes.size()), &subgraphs);
+
+		ASSERT_EQ(subgraphs.size(), component_sizes.size());
+
+		std::uint32_t edge_count = 0;
+		for(std::size_t i = 0; i < subgraphs.size(); ++i)
+		{
+			EXPECT_EQ(subgraphs[i]->get_vertex_count(), component_sizes[i]);
+			edge_count += subgraphs[i]->get_edge_count();
+		}
+		EXPECT_EQ(edge_count, gg.get_edge_count());
+	}
+}
+
+TEST(graph_algorithm, connected_component_with_union_find_sparse_ids)
+{
+	graph::graph gg;
+	graph::algorithm ga;
+	std::vector<std::shared_ptr<graph::graph>> subgraphs;
+	std::vector<std::uint32_t> component, component_sizes;
+
+	gg.add_vertex(3, 1.0);
+	gg.add_directed_edge(1000000, 7, 1.0);
+	gg.add_undirected_edge(7, 2, 1.0);
+
+	ga.connected_component_with_union_find(&gg, &component, &component_sizes);
+
+	// Indices: 2, 3, 7, 1000000
+	EXPECT_EQ(component, (std::vector<std::uint32_t>{ 0, 1, 0, 0 }));
+	EXPECT_EQ(component_sizes, (std::vector<std::uint32_t>{ 3, 1 }));
+
+	ga.create_component_subgraphs(&gg, component, 2, &subgraphs);
+
+	ASSERT_EQ(subgraphs.size(), 2);
+	EXPECT_EQ(subgraphs[0]->get_edge_count(), 3);
+	EXPECT_NE(subgraphs[0]->get_vertex(1000000), nullptr);
+	ASSERT_NE(subgraphs[1]->get_vertex(3), nullptr);
+	EXPECT_EQ(subgraphs[1]->get_vertex(3)->get_balance(), 1.0);
+}
+
+TEST(graph_edge_source, stream_matches_loaded_graph)
+{
+	graph::loader gl;
+	graph::algorithm ga;
+
+	for(const auto file : { graph::files::Graph1, graph::files::Graph2, graph::files::Graph3 })
+	{
+		graph::graph gg;
+		std::vector<std::shared_ptr<graph::graph>> subgraphs;
+		graph::disjoint_set components;
+		graph::degree_statistics statistics;
+
+		gl.load(file, gg);
+		ga.connected_component_with_bfs(&gg, &subgraphs);
+
+		std::unique_ptr<graph::edge_source> edges = gl.open_edge_source(file);
+
+		ASSERT_TRUE(ga.connected_component_with_union_find(edges.get(), &components));
+		EXPECT_EQ(components.get_set_count(), subgraphs.size());
+
+		ASSERT_TRUE(ga.compute_degree_statistics(edges.get(), &statistics));
+		EXPECT_EQ(statistics.edge_count * 2, gg.get_edge_count());
+		ASSERT_EQ(statistics.out_degrees.size(), gg.get_vertex_count());
+
+		for(auto vertices = gg.get_vertices(); vertices.first != vertices.second; ++vertices.first)
+		{
+			const graph::vertex* v = *vertices.first;
+
+			EXPECT_EQ(
+				statistics.out_degrees[v->get_id()] + statistics.in_degrees[v->get_id()],
+				v->get_out_degree());
+		}
+	}
+
+	graph::file_edge_source missing(
+		"../graph/does_not_exist.txt", graph::edge_format::edge_list);
+	graph::disjoint_set components;
+
+	EXPECT_FALSE(ga.connected_component_with_union_find(&missing, &components));
+}
+
+TEST(graph_algorithm_stream, kruskal_sorted_g_1_2)
+{
+	const std::string file_name = "graph_stream_test_sorted.txt";
+
+	graph::graph gg;
+	graph::loader gl;
+	graph::algorithm ga;
+
+	gl.load(graph::files::G_1_2, gg);
+
+	// Write the edge list sorted by weight.
+	std::vector<graph::graph::edge_record> records;
+	std::unique_ptr<graph::edge_source> edges = gl.open_edge_source(graph::files::G_1_2);
+
+	edges->read_edges(
+		[&records](const graph::graph::edge_record& record)
+		{
+			records.push_back(record);
+			return true;
+		});
+	std::stable_sort(records.begin(), records.end(),
+		[](const graph::graph::edge_record& lhs, const graph::graph::edge_record& rhs)
+		{
+			return lhs.weight < rhs.weight;
+		});
+
+	{
+		std::ofstream file(file_name);
+
+		file.precision(17);
+		file << edges->get_vertex_count() << "\n";
+		for(const auto& record : records)
+			file << record.source_id << "\t" << record.target_id << "\t" << record.weight << "\n";
+	}
+
+	graph::file_edge_source sorted(file_name, graph::edge_format::edge_list_weighted);
+	graph::graph mst_graph, mst_stream_graph;
+	double mst_cost = 0.0, mst_stream_cost = 0.0;
+
+	ga.kruskal(&gg, &mst_graph, &mst_cost);
+	ASSERT_TRUE(ga.kruskal(&sorted, &mst_stream_graph, &mst_stream_cost));
+
+	EXPECT_NEAR(mst_cost, mst_stream_cost, 1e-9);
+	EXPECT_EQ(mst_stream_graph.get_vertex_count(), gg.get_vertex_count());
+	EXPECT_EQ(mst_stream_graph.get_edge_count(), (gg.get_vertex_count() - 1) * 2);
+
+	// The unsorted file is rejected.
+	graph::graph mst_unsorted_graph;
+	double mst_unsorted_cost = 0.0;
+
+	EXPECT_FALSE(ga.kruskal(edges.get(), &mst_unsorted_graph, &mst_unsorted_cost));
+	EXPECT_EQ(mst_unsorted_graph.get_edge_count(), 0);
+	EXPECT_EQ(mst_unsorted_cost, 0.0);
+
+	std::remove(file_name.c_str());
+}
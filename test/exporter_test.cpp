@@ -0,0 +1,276 @@
+#include <gtest/gtest.h>
+#include <graph.h>
+#include <graph_algorithm.h>
+#include <graph_csr_graph.h>
+#include <graph_edge_source.h>
+#include <graph_exporter.h>
+#include <graph_loader.h>
+#include <graph_mapped_file.h>
+#include <graph_text_parser.h>
+#include <graph_vertex.h>
+#include <graph_edge.h>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+std::string read_file(const std::string& file_name)
+{
+	const graph::mapped_file file(file_name);
+	return std::string(file.get_data(), file.get_size());
+}
+
+//
+// Build a graph from an exported edge list.
+//
+void build_from_edge_list(
+	const std::string& file_name,
+	const graph::edge_format format,
+	const bool create_directed_graph,
+	graph::graph* gg)
+{
+	graph::file_edge_source edges(file_name, format);
+	std::vector<graph::graph::edge_record> records;
+
+	ASSERT_TRUE(edges.read_edges(
+		[&records](const graph::graph::edge_record& record)
+		{
+			records.push_back(record);
+			return true;
+		}));
+
+	gg->add_edges(records, edges.get_vertex_count(), create_directed_graph);
+}
+
+}
+
+TEST(graph_exporter, tgf)
+{
+	const std::string file_name = "graph_exporter_test.tgf";
+
+	graph::graph gg;
+	graph::exporter ex;
+
+	gg.add_vertex(0, 2.0);
+	gg.add_vertex(1, -2.0);
+	gg.add_directed_edge(0, 1, 3.0, 4.5);
+	gg.add_undirected_edge(1, 2, 0.25);
+
+	ASSERT_TRUE(ex.save_tgf(file_name, gg));
+	EXPECT_EQ(read_file(file_name),
+		"0\t0/2\n"
+		"1\t1/-2\n"
+		"2\t2\n"
+		"#\n"
+		"0\t1\t4.5/3\n"
+		"1\t2\t0.25\n");
+
+	std::remove(file_name.c_str());
+}
+
+TEST(graph_exporter, edge_list_weighted_round_trip)
+{
+	const std::string file_name = "graph_exporter_test.txt";
+
+	graph::graph gg, gg_exported;
+	graph::loader gl;
+	graph::exporter ex;
+
+	gl.load(graph::files::G_1_2, gg);
+
+	ASSERT_TRUE(ex.save_edge_list(file_name, gg, graph::edge_format::edge_list_weighted));
+	build_from_edge_list(file_name, graph::edge_format::edge_list_weighted, false, &gg_exported);
+
+	ASSERT_EQ(gg_exported.get_vertex_count(), gg.get_vertex_count());
+	ASSERT_EQ(gg_exported.get_edge_count(), gg.get_edge_count());
+
+	// The shortest text of a double reads back to the same value.
+	for(const graph::edge* e : gg.get_edges())
+	{
+		const graph::edge* exported = gg_exported.get_edge(
+			gg_exported.get_vertex(e->get_source()->get_id()),
+			gg_exported.get_vertex(e->get_target()->get_id()));
+
+		ASSERT_NE(exported, nullptr);
+		EXPECT_EQ(exported->get_weight(), e->get_weight());
+	}
+
+	std::remove(file_name.c_str());
+}
+
+TEST(graph_exporter, edge_list_minimum_cost_flow_round_trip)
+{
+	const std::string file_name = "graph_exporter_test.txt";
+
+	graph::graph gg, gg_exported;
+	graph::loader gl;
+	graph::algorithm ga;
+	graph::exporter ex;
+
+	gl.load(graph::files::Kostenminimal1, gg);
+
+	ASSERT_TRUE(ex.save_edge_list(
+		file_name, gg, graph::edge_format::edge_list_minimum_cost_flow));
+	EXPECT_FALSE(ex.save_edge_list(
+		file_name, gg, graph::edge_format::adjacent_matrix));
+
+	{
+		const graph::mapped_file file(file_name);
+		graph::text_parser parser(file.get_data(), file.get_data() + file.get_size());
+		std::uint32_t vertex_count = 0;
+
+		ASSERT_TRUE(parser.read(&vertex_count));
+		for(std::uint32_t id = 0; id < vertex_count; ++id)
+		{
+			double balance = 0.0;
+
+			ASSERT_TRUE(parser.read(&balance));
+			gg_exported.add_vertex(id, balance);
+		}
+	}
+	build_from_edge_list(
+		file_name, graph::edge_format::edge_list_minimum_cost_flow, true, &gg_exported);
+
+	bool found = false, found_exported = false;
+	double cost = 0.0, cost_exported = 0.0;
+
+	ga.successive_shortest_path(&gg, &found, &cost);
+	ga.successive_shortest_path(&gg_exported, &found_exported, &cost_exported);
+
+	EXPECT_EQ(found_exported, found);
+	EXPECT_EQ(cost_exported, cost);
+
+	std::remove(file_name.c_str());
+}
+
+TEST(graph_exporter, binary_graph)
+{
+	const std::string file_name = "graph_exporter_test.bin";
+
+	graph::graph gg;
+	graph::csr_graph snapshot;
+	graph::loader gl;
+	graph::exporter ex;
+
+	gl.load(graph::files::Graph1, gg);
+
+	ASSERT_TRUE(ex.save_binary(file_name, gg));
+	ASSERT_TRUE(gl.load_snapshot(file_name, &snapshot));
+	EXPECT_EQ(snapshot.get_vertex_count(), gg.get_vertex_count());
+	EXPECT_EQ(snapshot.get_edge_count(), gg.get_edge_count());
+
+	std::remove(file_name.c_str());
+}
+
+TEST(graph_exporter, distances)
+{
+	const std::string file_name = "graph_exporter_test.txt";
+	const double infinity = std::numeric_limits<double>::infinity();
+
+	graph::exporter ex;
+
+	ASSERT_TRUE(ex.save_distances(file_name, std::vector<double>{ 0.0, 1.5, infinity }));
+	EXPECT_EQ(read_file(file_name), "3\n0\n1.5\ninf\n");
+
+	ASSERT_TRUE(ex.save_distances(
+		file_name, std::unordered_map<std::uint32_t, double>{ { 7, 2.0 }, { 3, 0.1 } }));
+	EXPECT_EQ(read_file(file_name), "3\t0.1\n7\t2\n");
+
+	// Binary: header and the raw doubles
+	const std::vector<double> distances{ 0.0, 0.1, 1e300, infinity };
+
+	ASSERT_TRUE(ex.save_distances_binary(file_name, distances));
+	{
+		const graph::mapped_file file(file_name);
+		graph::exporter::result_header header;
+
+		ASSERT_EQ(file.get_size(), sizeof(header) + distances.size() * sizeof(double));
+		std::memcpy(&header, file.get_data(), sizeof(header));
+		EXPECT_EQ(std::memcmp(header.magic, graph::exporter::result_magic, sizeof(header.magic)), 0);
+		EXPECT_EQ(header.kind, graph::exporter::result_distances);
+		EXPECT_EQ(header.count, distances.size());
+		EXPECT_EQ(std::memcmp(
+			file.get_data() + sizeof(header), distances.data(), distances.size() * sizeof(double)), 0);
+	}
+
+	std::remove(file_name.c_str());
+}
+
+TEST(graph_exporter, flow)
+{
+	const std::string file_name = "graph_exporter_test.txt";
+
+	graph::graph gg;
+	graph::exporter ex;
+	graph::exporter::flow_map flow_per_edge;
+
+	gg.add_directed_edge(2, 1, 1.0);
+	gg.add_directed_edge(0, 1, 1.0);
+	gg.add_directed_edge(0, 2, 1.0);
+
+	for(const graph::edge* e : gg.get_edges())
+		flow_per_edge[e] = e->get_source()->get_id() + 0.5;
+
+	ASSERT_TRUE(ex.save_flow(file_name, flow_per_edge));
+	EXPECT_EQ(read_file(file_name), "0\t1\t0.5\n0\t2\t0.5\n2\t1\t2.5\n");
+
+	ASSERT_TRUE(ex.save_flow_binary(file_name, flow_per_edge));
+	{
+		const graph::mapped_file file(file_name);
+		graph::exporter::result_header header;
+		graph::exporter::flow_record last;
+
+		ASSERT_EQ(file.get_size(), sizeof(header) + 3 * sizeof(last));
+		std::memcpy(&header, file.get_data(), sizeof(header));
+		std::memcpy(&last, file.get_data() + sizeof(header) + 2 * sizeof(last), sizeof(last));
+		EXPECT_EQ(header.kind, graph::exporter::result_flow);
+		EXPECT_EQ(header.count, 3);
+		EXPECT_EQ(last.source_id, 2);
+		EXPECT_EQ(last.target_id, 1);
+		EXPECT_EQ(last.flow, 2.5);
+	}
+
+	std::remove(file_name.c_str());
+}
+
+TEST(graph_exporter, unwritable_file)
+{
+	graph::graph gg;
+	graph::exporter ex;
+
+	EXPECT_FALSE(ex.save_tgf("missing_directory/graph.tgf", gg));
+	EXPECT_FALSE(ex.save_distances("missing_directory/distances.txt", std::vector<double>()));
+}
+
+TEST(graph_exporter, missing_edge_values)
+{
+	const std::string file_name = "graph_exporter_test.txt";
+
+	graph::graph gg;
+	graph::loader gl;
+	graph::exporter ex;
+
+	// Graph2 has no weights.
+	gl.load(graph::files::Graph2, gg);
+
+	EXPECT_TRUE(ex.save_edge_list(file_name, gg, graph::edge_format::edge_list));
+	EXPECT_FALSE(ex.save_edge_list(file_name, gg, graph::edge_format::edge_list_weighted));
+	EXPECT_FALSE(ex.save_edge_list(file_name, gg, graph::edge_format::edge_list_minimum_cost_flow));
+
+	// A cost without capacity has no tgf label.
+	graph::graph gg_cost;
+	graph::edge e;
+
+	e.set_source(gg_cost.add_vertex(1));
+	e.set_target(gg_cost.add_vertex(2));
+	e.set_cost(2.0);
+	gg_cost.add_edge(&e);
+
+	EXPECT_FALSE(ex.save_tgf(file_name, gg_cost));
+
+	std::remove(file_name.c_str());
+}
@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include <graph.h>
+#include <graph_algorithm.h>
+#include <graph_compressed_graph.h>
+#include <graph_disjoint_set.h>
+#include <graph_generator.h>
+#include <graph_vertex.h>
+#include <graph_edge.h>
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+std::vector<graph::graph::edge_record> read_all(graph::edge_source* edges)
+{
+	std::vector<graph::graph::edge_record> records;
+
+	edges->read_edges(
+		[&records](const graph::graph::edge_record& record)
+		{
+			records.push_back(record);
+			return true;
+		});
+
+	return records;
+}
+
+bool same_edges(
+	const std::vector<graph::graph::edge_record>& lhs,
+	const std::vector<graph::graph::edge_record>& rhs)
+{
+	if(lhs.size() != rhs.size())
+		return false;
+
+	for(std::size_t i = 0; i < lhs.size(); ++i)
+	{
+		if(lhs[i].source_id != rhs[i].source_id ||
+			lhs[i].target_id != rhs[i].target_id ||
+			!(lhs[i].weight == rhs[i].weight ||
+				(std::isnan(lhs[i].weight) && std::isnan(rhs[i].weight))))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+}
+
+TEST(graph_generator, reproducible)
+{
+	graph::generator first = graph::generator::erdos_renyi(1000, 5000, 42);
+	graph::generator second = graph::generator::erdos_renyi(1000, 5000, 42);
+	graph::generator other = graph::generator::erdos_renyi(1000, 5000, 43);
+
+	const auto records = read_all(&first);
+
+	ASSERT_EQ(records.size(), 5000);
+	EXPECT_TRUE(same_edges(records, read_all(&first)));
+	EXPECT_TRUE(same_edges(records, read_all(&second)));
+	EXPECT_FALSE(same_edges(records, read_all(&other)));
+
+	for(const auto& record : records)
+	{
+		EXPECT_NE(record.source_id, record.target_id);
+		EXPECT_LT(record.source_id, 1000);
+		EXPECT_LT(record.target_id, 1000);
+		EXPECT_GE(record.weight, 0.0);
+		EXPECT_LT(record.weight, 1.0);
+	}
+
+	// A generated graph can be streamed without building a graph.
+	graph::generator rmat = graph::generator::rmat(12, 40000, 7);
+	const graph::compressed_graph compressed(&rmat, true);
+
+	EXPECT_EQ(compressed.get_vertex_count(), 4096);
+	EXPECT_EQ(compressed.get_edge_count(), 40000);
+}
+
+TEST(graph_generator, grid_and_geometric)
+{
+	graph::graph gg;
+	graph::algorithm ga;
+	graph::generator grid = graph::generator::grid(30, 40, 1);
+
+	grid.build(gg);
+
+	EXPECT_EQ(gg.get_vertex_count(), 1200);
+	EXPECT_EQ(gg.get_edge_count(), 2 * (30 * 39 + 29 * 40));
+
+	std::vector<std::shared_ptr<graph::graph>> subgraphs;
+	ga.connected_component_with_bfs(&gg, &subgraphs);
+	EXPECT_EQ(subgraphs.size(), 1);
+
+	// The bucketing finds the same pairs as comparing all of them.
+	const double radius = 0.05;
+	graph::generator geometric = graph::generator::random_geometric(2000, radius, 3);
+	graph::generator complete = graph::generator::complete_euclidean(2000, 3);
+	std::size_t close_pairs = 0;
+
+	complete.read_edges(
+		[&](const graph::graph::edge_record& record)
+		{
+			close_pairs += record.weight < radius;
+			return true;
+		});
+
+	const auto records = read_all(&geometric);
+
+	EXPECT_EQ(records.size(), close_pairs);
+	for(const auto& record : records)
+	{
+		EXPECT_LT(record.source_id, record.target_id);
+		EXPECT_LT(record.weight, radius);
+	}
+}
+
+TEST(graph_generator, complete_bipartite_and_flow)
+{
+	graph::algorithm ga;
+
+	graph::graph complete_graph, mst_graph;
+	graph::generator complete = graph::generator::complete_euclidean(50, 5);
+	double mst_cost = 0.0;
+
+	complete.build(complete_graph);
+	EXPECT_EQ(complete_graph.get_edge_count(), 50 * 49);
+
+	ga.prim(&complete_graph, complete_graph.get_vertex(0), &mst_graph, &mst_cost);
+	EXPECT_GT(mst_cost, 0.0);
+
+	graph::graph bipartite_graph;
+	graph::generator bipartite = graph::generator::bipartite(100, 80, 400, 5);
+	double matchings = 0.0;
+
+	bipartite.build(bipartite_graph);
+	for(const auto& record : read_all(&bipartite))
+	{
+		EXPECT_LT(record.source_id, 100);
+		EXPECT_GE(record.target_id, 100);
+	}
+
+	ga.maximal_matching(&bipartite_graph, 100, &matchings);
+	EXPECT_GT(matchings, 0.0);
+	EXPECT_LE(matchings, 80.0);
+
+	graph::graph flow_graph;
+	graph::generator flow = graph::generator::minimum_cost_flow(30, 120, 10, 5);
+	double balance = 0.0;
+
+	flow.build(flow_graph);
+	EXPECT_EQ(flow_graph.get_edge_count(), 150);
+	for(const graph::vertex* v : flow_graph.get_vertices())
+	{
+		EXPECT_LE(std::abs(v->get_balance()), 10.0);
+		balance += v->get_balance();
+	}
+	EXPECT_EQ(balance, 0.0);
+
+	bool minimum_cost_flow_found = false;
+	double minimum_cost_flow = 0.0;
+
+	ga.successive_shortest_path(&flow_graph, &minimum_cost_flow_found, &minimum_cost_flow);
+	EXPECT_TRUE(minimum_cost_flow_found);
+}
+
+TEST(graph_generator, edge_count_limits)
+{
+	// Every vertex pair once, without parallel edges.
+	graph::generator all_pairs = graph::generator::erdos_renyi(50, 50 * 49 / 2, 9);
+	std::set<std::pair<std::uint32_t, std::uint32_t>> pairs;
+
+	ASSERT_TRUE(all_pairs.is_valid());
+	for(const auto& record : read_all(&all_pairs))
+	{
+		EXPECT_NE(record.source_id, record.target_id);
+		pairs.insert(std::minmax(record.source_id, record.target_id));
+	}
+	EXPECT_EQ(pairs.size(), 50 * 49 / 2);
+
+	// The densest flow network uses every pair once, the cycle included.
+	graph::generator dense_flow = graph::generator::minimum_cost_flow(20, 20 * 19 / 2 - 20, 5, 9);
+
+	pairs.clear();
+	ASSERT_TRUE(dense_flow.is_valid());
+	for(const auto& record : read_all(&dense_flow))
+	{
+		EXPECT_NE(record.source_id, record.target_id);
+		pairs.insert(std::minmax(record.source_id, record.target_id));
+	}
+	EXPECT_EQ(pairs.size(), 20 * 19 / 2);
+
+	// More edges than vertex pairs give an invalid generator without edges.
+	graph::generator too_many = graph::generator::erdos_renyi(50, 50 * 49 / 2 + 1, 9);
+	graph::generator too_many_flow = graph::generator::minimum_cost_flow(20, 20 * 19 / 2 - 19, 5, 9);
+	graph::generator too_small_flow = graph::generator::minimum_cost_flow(2, 0, 5, 9);
+	graph::generator bad_rmat = graph::generator::rmat(32, 10, 9);
+	graph::generator too_large_grid = graph::generator::grid(70000, 70000, 9);
+	graph::graph gg;
+
+	EXPECT_FALSE(too_many.is_valid());
+	EXPECT_FALSE(too_many_flow.is_valid());
+	EXPECT_FALSE(too_small_flow.is_valid());
+	EXPECT_FALSE(bad_rmat.is_valid());
+	EXPECT_FALSE(too_large_grid.is_valid());
+	EXPECT_TRUE(graph::generator::grid(65536, 65535, 9).is_valid());
+	EXPECT_FALSE(too_many.read_edges(
+		[](const graph::graph::edge_record&) { return true; }));
+	EXPECT_TRUE(read_all(&too_many_flow).empty());
+
+	too_many.build(gg);
+	EXPECT_EQ(gg.get_edge_count(), 0);
+}
@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 #include <graph.h>
+#include <graph_arena.h>
 #include <graph_vertex.h>
 #include <graph_edge.h>
 #include <graph_comparer.h>
+#include <graph_vertex_with_balance.h>
+#include <iterator>
 #include <unordered_map>
 
 TEST(graph_vertex, std_map_test)
@@ -112,3 +115,349 @@ TEST(graph_graph, return_edges)
 
 	return;
 }
+
+TEST(graph_edge, create_key)
+{
+	graph::edge e0, e1;
+	graph::vertex v0(7), v1(0xFFFFFFFF);
+
+	EXPECT_EQ(graph::edge::create_key(7, 3), (std::uint64_t(7) << 32) | 3);
+	EXPECT_NE(graph::edge::create_key(7, 3), graph::edge::create_key(3, 7));
+	EXPECT_EQ(
+		graph::edge::create_undirected_key(7, 3),
+		graph::edge::create_undirected_key(3, 7));
+
+	e0.set_source(&v0);
+	e0.set_target(&v1);
+	e1.set_source(&v1);
+	e1.set_target(&v0);
+
+	EXPECT_EQ(e0.get_hash(), e1.get_hash());
+	EXPECT_NE(graph::directed_edge_hash()(&e0), graph::directed_edge_hash()(&e1));
+}
+
+TEST(graph_graph, get_edge_after_remove_edges)
+{
+	graph::graph g;
+
+	g.add_undirected_edge(0, 1, 1.0);
+	g.add_undirected_edge(1, 2, 2.0);
+	g.add_directed_edge(2, 3, 3.0);
+
+	const graph::vertex* v1 = g.get_vertex(1);
+	const graph::vertex* v2 = g.get_vertex(2);
+	const graph::vertex* v3 = g.get_vertex(3);
+
+	EXPECT_EQ(g.get_edge(v1, v2)->get_weight(), 2.0);
+	EXPECT_EQ(g.get_edge(v2, v1)->get_twin(), g.get_edge(v1, v2));
+	EXPECT_EQ(g.get_edge(v2, v3)->get_weight(), 3.0);
+
+	g.remove_edges(v1, v2);
+
+	EXPECT_EQ(g.get_edge_count(), 3);
+	EXPECT_EQ(g.get_edge(g.get_vertex(0), v1)->get_weight(), 1.0);
+	EXPECT_EQ(g.get_edge(v2, v3)->get_weight(), 3.0);
+
+	for(const graph::edge* e : v1->get_edges())
+		EXPECT_NE(e->get_target()->get_id(), 2);
+}
+
+TEST(graph_arena, reserve_after_partial_use)
+{
+	graph::arena<int> a;
+	std::vector<int*> objects;
+
+	// 64 slots of the first chunk, 10 of them used and 2 destroyed again.
+	for(int i = 0; i < 10; ++i)
+		objects.push_back(a.create(i));
+	a.destroy(objects[3]);
+	a.destroy(objects[7]);
+
+	ASSERT_EQ(a.get_capacity(), 64);
+
+	// 56 slots are left, only the missing 44 are allocated.
+	a.reserve(100);
+	EXPECT_EQ(a.get_capacity(), 108);
+
+	// All reserved objects fit, the leftover of the first chunk included.
+	for(int i = 0; i < 100; ++i)
+		EXPECT_EQ(*a.create(i), i);
+	EXPECT_EQ(a.get_capacity(), 108);
+
+	// A full arena allocates exactly the reservation, a fitting one nothing.
+	a.reserve(10);
+	a.reserve(10);
+	EXPECT_EQ(a.get_capacity(), 118);
+
+	for(int i = 0; i < 10; ++i)
+		a.create(i);
+	EXPECT_EQ(a.get_capacity(), 118);
+}
+
+TEST(graph_graph, dense_and_sparse_vertex_ids)
+{
+	graph::graph g;
+	std::vector<std::uint32_t> ids;
+
+	g.add_vertex(4000000000u);
+	g.add_vertex(3);
+	g.add_vertex(0u);
+	g.add_vertex(70000);
+	g.add_undirected_edge(1, 70000);
+
+	EXPECT_EQ(g.get_vertex_count(), 5);
+	EXPECT_EQ(g.get_vertex(2), nullptr);
+	EXPECT_EQ(g.get_vertex(70000)->get_id(), 70000);
+	EXPECT_EQ(g.get_vertex(4000000000u)->get_id(), 4000000000u);
+
+	// Iteration is ordered by id, independent of dense or sparse storage.
+	for(const graph::vertex* v : g.get_vertices())
+		ids.push_back(v->get_id());
+
+	EXPECT_EQ(ids, std::vector<std::uint32_t>({ 0, 1, 3, 70000, 4000000000u }));
+
+	graph::graph h;
+	h.add_vertex(7);
+	EXPECT_EQ(h.add_vertex(nullptr, nullptr)->get_id(), 8);
+}
+
+TEST(graph_edge, typed_vertex_access)
+{
+	graph::edge e;
+	graph::vertex v0(0);
+	graph::vertex_with_balance v1(1, 5.0);
+
+	e.set_source(&v0);
+	e.set_target(&v1);
+
+	// Base type without runtime check, derived type checked.
+	EXPECT_EQ(e.get_source(), &v0);
+	EXPECT_EQ(e.get_target<graph::vertex_with_balance>(), &v1);
+	EXPECT_EQ(e.get_target<graph::vertex_with_balance>()->get_balance(), 5.0);
+}
+
+TEST(graph_graph, copy_and_move)
+{
+	graph::graph g;
+
+	g.add_undirected_edge(0, 1, 2.0);
+	g.add_directed_edge(1, 2, 3.0);
+
+	// A copy owns its own edges and keeps the twins linked.
+	graph::graph copy(g);
+	const graph::edge* e01 = copy.get_edge(copy.get_vertex(0), copy.get_vertex(1));
+
+	EXPECT_NE(e01, g.get_edge(g.get_vertex(0), g.get_vertex(1)));
+	EXPECT_EQ(e01->get_twin(), copy.get_edge(copy.get_vertex(1), copy.get_vertex(0)));
+	EXPECT_EQ(e01->get_twin()->get_twin(), e01);
+
+	// Changing the copy leaves the original and its handles unchanged.
+	const graph::vertex* v0 = g.get_vertex(0);
+
+	copy.add_directed_edge(2, 3, 4.0);
+	copy.add_undirected_edge(0, 2);
+
+	EXPECT_EQ(copy.get_edge_count(), 6);
+	EXPECT_EQ(copy.get_vertex_count(), 4);
+	EXPECT_EQ(g.get_edge_count(), 3);
+	EXPECT_EQ(g.get_vertex(3), nullptr);
+	EXPECT_EQ(g.get_vertex(0), v0);
+	EXPECT_EQ(v0->get_out_degree(), 1);
+
+	// A move keeps the handles, the moved from graph is empty and usable.
+	graph::graph moved(std::move(g));
+
+	EXPECT_EQ(moved.get_vertex(0), v0);
+	EXPECT_EQ(moved.get_edge_count(), 3);
+	EXPECT_EQ(g.get_edge_count(), 0);
+	EXPECT_EQ(g.get_vertex_count(), 0);
+
+	g.add_directed_edge(0, 1);
+
+	EXPECT_EQ(g.get_edge_count(), 1);
+	EXPECT_EQ(moved.get_edge_count(), 3);
+}
+
+TEST(graph_graph, add_edges)
+{
+	graph::graph g;
+	std::vector<graph::graph::edge_record> records;
+	graph::graph::edge_record flow_record = { 3, 0 };
+
+	flow_record.cost = 4.0;
+	flow_record.capacity = 5.0;
+
+	records.push_back({ 0, 1, 2.0 });
+	records.push_back({ 1, 2 });
+	records.push_back(flow_record);
+
+	g.add_edges(records, 5, false);
+
+	EXPECT_EQ(g.get_vertex_count(), 5);
+	EXPECT_EQ(g.get_edge_count(), 6);
+
+	const graph::edge* e01 = g.get_edge(g.get_vertex(0), g.get_vertex(1));
+	const graph::edge* e12 = g.get_edge(g.get_vertex(1), g.get_vertex(2));
+	const graph::edge* e03 = g.get_edge(g.get_vertex(0), g.get_vertex(3));
+
+	EXPECT_EQ(e01->get_weight(), 2.0);
+	EXPECT_EQ(e01->get_twin()->get_twin(), e01);
+	EXPECT_FALSE(e12->has_weight());
+	EXPECT_FALSE(e03->has_weight());
+	EXPECT_EQ(e03->get_cost(), 4.0);
+	EXPECT_EQ(e03->get_capacity(), 5.0);
+
+	// Directed edges into existing and new vertices.
+	records.clear();
+	records.push_back({ 4, 7, 1.0 });
+	g.add_edges(records, 0, true);
+
+	EXPECT_EQ(g.get_vertex_count(), 6);
+	EXPECT_EQ(g.get_edge_count(), 7);
+	EXPECT_FALSE(g.get_edge(g.get_vertex(4), g.get_vertex(7))->has_twin());
+
+	// The edge list stays consistent after removals.
+	g.remove_edges(g.get_vertex(0), g.get_vertex(1));
+
+	std::uint32_t edge_count = 0;
+	for(const graph::edge* e : g.get_edges())
+	{
+		EXPECT_NE(e, e01);
+		++edge_count;
+	}
+	EXPECT_EQ(edge_count, 5);
+}
+
+TEST(graph_vertex, pointing_edges)
+{
+	graph::graph g;
+	std::vector<std::uint32_t> sources;
+
+	g.add_directed_edge(0, 2, 1.0);
+	g.add_directed_edge(1, 2, 2.0);
+	g.add_directed_edge(2, 3, 3.0);
+	g.add_undirected_edge(3, 4);
+
+	const graph::vertex* v2 = g.get_vertex(2);
+
+	EXPECT_EQ(v2->get_in_degree(), 2);
+	EXPECT_EQ(v2->get_out_degree(), 1);
+
+	for(const graph::edge* e : v2->get_pointing_edges())
+	{
+		EXPECT_EQ(e->get_target(), v2);
+		sources.push_back(e->get_source()->get_id());
+	}
+	EXPECT_EQ(sources, std::vector<std::uint32_t>({ 0, 1 }));
+
+	// The twin of an undirected edge points to the source.
+	EXPECT_EQ(g.get_vertex(3)->get_in_degree(), 2);
+	EXPECT_EQ(g.get_vertex(4)->get_in_degree(), 1);
+
+	g.remove_edges(g.get_vertex(0), v2);
+
+	EXPECT_EQ(v2->get_in_degree(), 1);
+	EXPECT_EQ(*v2->get_pointing_edges().first, g.get_edge(g.get_vertex(1), v2));
+
+	// Bulk build and copies keep the pointing edges.
+	graph::graph h;
+	std::vector<graph::graph::edge_record> records;
+
+	records.push_back({ 0, 1 });
+	records.push_back({ 2, 1 });
+	h.add_edges(records, 3, true);
+
+	graph::graph copy(h);
+
+	EXPECT_EQ(h.get_vertex(1)->get_in_degree(), 2);
+	EXPECT_EQ(copy.get_vertex(1)->get_in_degree(), 2);
+	EXPECT_EQ(copy.get_vertex(0)->get_in_degree(), 0);
+}
+
+TEST(graph_graph, remove_edge_and_vertex)
+{
+	graph::graph g;
+
+	g.add_undirected_edge(0, 1, 1.0);
+	g.add_undirected_edge(1, 2, 2.0);
+	g.add_directed_edge(2, 0, 3.0);
+	g.add_directed_edge(3, 1, 4.0);
+
+	const graph::vertex* v0 = g.get_vertex(0);
+	const graph::vertex* v1 = g.get_vertex(1);
+	const graph::vertex* v2 = g.get_vertex(2);
+	const graph::edge* e20 = g.get_edge(v2, v0);
+
+	// Removing an undirected edge removes the twin, other handles stay valid.
+	g.remove_edge(*g.get_edge(v0, v1));
+
+	EXPECT_EQ(g.get_edge_count(), 4);
+	EXPECT_EQ(v0->get_out_degree(), 0);
+	EXPECT_EQ(v0->get_in_degree(), 1);
+	EXPECT_EQ(v1->get_out_degree(), 1);
+	EXPECT_EQ(g.get_edge(v2, v0), e20);
+	EXPECT_EQ(e20->get_weight(), 3.0);
+
+	g.remove_vertex(v1);
+
+	EXPECT_EQ(g.get_vertex(1), nullptr);
+	EXPECT_EQ(g.get_vertex_count(), 3);
+	EXPECT_EQ(g.get_edge_count(), 1);
+	EXPECT_EQ(g.get_vertex(3)->get_out_degree(), 0);
+	EXPECT_EQ(v2->get_in_degree(), 0);
+
+	// The vertex id can be used again.
+	g.add_directed_edge(1, 0, 5.0);
+
+	EXPECT_EQ(g.get_vertex_count(), 4);
+	EXPECT_EQ(v0->get_in_degree(), 2);
+
+	// Removing from a copy leaves the original unchanged.
+	graph::graph copy(g);
+
+	EXPECT_TRUE(copy.remove_edge(
+		*copy.get_edge(copy.get_vertex(1), copy.get_vertex(0))));
+
+	EXPECT_EQ(copy.get_edge_count(), 1);
+	EXPECT_EQ(g.get_edge_count(), 2);
+	EXPECT_EQ(g.get_edge(v2, v0), e20);
+
+	// The copy has swap popped its edge list, so the positions of both
+	// graphs differ. An edge of the original is not removed from it.
+	EXPECT_FALSE(copy.remove_edge(*e20));
+	EXPECT_EQ(copy.get_edge_count(), 1);
+
+	EXPECT_TRUE(copy.remove_edge(
+		*copy.get_edge(copy.get_vertex(2), copy.get_vertex(0))));
+	EXPECT_EQ(copy.get_edge_count(), 0);
+	EXPECT_EQ(g.get_edge_count(), 2);
+
+	// An edge of another graph is not removed, even with the same ids.
+	graph::graph other;
+
+	other.add_directed_edge(3, 3);
+	other.add_directed_edge(2, 0, 3.0);
+
+	EXPECT_FALSE(g.remove_edge(*other.get_edge(other.get_vertex(2), other.get_vertex(0))));
+	EXPECT_EQ(g.get_edge_count(), 2);
+	EXPECT_EQ(g.get_edge(v2, v0), e20);
+}
+
+TEST(graph_graph, remove_parallel_edge)
+{
+	graph::graph g;
+
+	g.add_directed_edge(0, 1, 1.0);
+	g.add_directed_edge(0, 1, 2.0);
+	g.add_directed_edge(0, 1, 3.0);
+
+	// The given edge is removed, not the first one with the same ids.
+	const graph::edge* e = *std::next(g.get_vertex(0)->get_edges().first);
+
+	ASSERT_EQ(e->get_weight(), 2.0);
+	EXPECT_TRUE(g.remove_edge(*e));
+	EXPECT_EQ(g.get_edge_count(), 2);
+
+	for(const graph::edge* remaining : g.get_edges())
+		EXPECT_NE(remaining->get_weight(), 2.0);
+}
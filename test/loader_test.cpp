@@ -0,0 +1,448 @@
+#include <gtest/gtest.h>
+#include <graph.h>
+#include <graph_algorithm.h>
+#include <graph_loader.h>
+#include <graph_graphml_reader.h>
+#include <graph_mapped_file.h>
+#include <graph_text_parser.h>
+#include <graph_thread_pool.h>
+#include <graph_vertex.h>
+#include <graph_edge.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+//
+// Write the edges of a directed graph as DIMACS arcs (1-based).
+// values writes the values behind source and target.
+//
+template<typename F>
+void write_dimacs_arcs(std::ofstream& file, const graph::graph& gg, F values)
+{
+	for(const graph::edge* e : gg.get_edges())
+	{
+		file << "a " << e->get_source()->get_id() + 1 << " " << e->get_target()->get_id() + 1;
+		values(file, e);
+		file << "\n";
+	}
+}
+
+}
+
+TEST(graph_loader, dimacs_shortest_path_wege1)
+{
+	const std::string file_name = "graph_loader_test.gr";
+
+	graph::graph gg, gg_dimacs;
+	graph::loader gl;
+	graph::algorithm ga;
+
+	gl.load(graph::files::Wege1, gg, true);
+
+	{
+		std::ofstream file(file_name);
+
+		file << "c Wege1.txt\nc\n";
+		file << "p sp " << gg.get_vertex_count() << " " << gg.get_edge_count() << "\n";
+		write_dimacs_arcs(file, gg,
+			[](std::ofstream& fs, const graph::edge* e) { fs << " " << e->get_weight(); });
+	}
+
+	ASSERT_TRUE(gl.load_dimacs_shortest_path(file_name, gg_dimacs));
+	ASSERT_EQ(gg_dimacs.get_vertex_count(), gg.get_vertex_count());
+	ASSERT_EQ(gg_dimacs.get_edge_count(), gg.get_edge_count());
+
+	std::unordered_map<std::uint32_t, const graph::edge*> predecessor;
+	std::unordered_map<std::uint32_t, double> distances;
+	bool negative_cycle_found = false;
+
+	ga.moore_bellman_ford(
+		&gg_dimacs, gg_dimacs.get_vertex(2), &predecessor, &distances, &negative_cycle_found);
+
+	EXPECT_EQ(distances[0], 6);
+	EXPECT_FALSE(negative_cycle_found);
+
+	// Another problem type is rejected.
+	graph::graph gg_wrong;
+	std::uint32_t source_id = 0, target_id = 0;
+
+	EXPECT_FALSE(gl.load_dimacs_maximum_flow(file_name, gg_wrong, &source_id, &target_id));
+	EXPECT_FALSE(gl.load_dimacs_shortest_path("../graph/does_not_exist.gr", gg_wrong));
+
+	std::remove(file_name.c_str());
+}
+
+TEST(graph_loader, dimacs_malformed_arc_with_any_thread_count)
+{
+	const std::string file_name = "graph_loader_test.gr";
+	const std::uint32_t arc_count = 300000;
+
+	// Large enough for several chunks, comment lines between the arcs.
+	// The malformed arc is written in front of arc number malformed_arc.
+	const auto write_file = [&](const std::uint32_t malformed_arc)
+	{
+		std::ofstream file(file_name);
+
+		file << "p sp 100 " << arc_count << "\n";
+		for(std::uint32_t i = 0; i <= arc_count; ++i)
+		{
+			if(i == malformed_arc)
+				file << "a 5 x 1\n";
+			if(i == arc_count)
+				break;
+			if(i % 1000 == 0)
+				file << "c arc " << i << "\n";
+			file << "a " << i % 100 + 1 << " " << i * 7 % 100 + 1 << " 1\n";
+		}
+		file << "c end\n";
+	};
+
+	// The malformed arc fails the load, also if the arcs behind it are
+	// parsed by another thread or if it is the last one.
+	for(const std::uint32_t malformed_arc : { arc_count + 1, arc_count / 3 * 2, arc_count })
+	{
+		write_file(malformed_arc);
+
+		for(std::size_t thread_count = 1; thread_count <= 4; ++thread_count)
+		{
+			graph::graph gg;
+			graph::loader gl;
+
+			gl.set_thread_count(thread_count);
+			EXPECT_EQ(gl.load_dimacs_shortest_path(file_name, gg), malformed_arc > arc_count);
+		}
+	}
+
+	std::remove(file_name.c_str());
+}
+
+TEST(graph_loader, dimacs_maximum_flow_fluss)
+{
+	const std::string file_name = "graph_loader_test.max";
+
+	graph::graph gg, gg_dimacs;
+	graph::loader gl;
+	graph::algorithm ga;
+
+	gl.load(graph::files::Fluss, gg, true);
+
+	{
+		std::ofstream file(file_name);
+
+		file << "p max " << gg.get_vertex_count() << " " << gg.get_edge_count() << "\n";
+		file << "n 1 s\nn 8 t\n";
+		write_dimacs_arcs(file, gg,
+			[](std::ofstream& fs, const graph::edge* e) { fs << " " << e->get_weight(); });
+	}
+
+	std::uint32_t source_id = 0, target_id = 0;
+	double maximum_flow = 0.0, maximum_flow_dimacs = 0.0;
+
+	ASSERT_TRUE(gl.load_dimacs_maximum_flow(file_name, gg_dimacs, &source_id, &target_id));
+	EXPECT_EQ(source_id, 0);
+	EXPECT_EQ(target_id, 7);
+
+	ga.edmonds_karp(&gg, gg.get_vertex(0), gg.get_vertex(7), &maximum_flow);
+	ga.edmonds_karp(
+		&gg_dimacs, gg_dimacs.get_vertex(source_id), gg_dimacs.get_vertex(target_id),
+		&maximum_flow_dimacs);
+
+	EXPECT_GT(maximum_flow, 0.0);
+	EXPECT_EQ(maximum_flow, maximum_flow_dimacs);
+
+	std::remove(file_name.c_str());
+}
+
+TEST(graph_loader, dimacs_minimum_cost_flow_kostenminimal1)
+{
+	const std::string file_name = "graph_loader_test.min";
+
+	graph::graph gg, gg_dimacs;
+	graph::loader gl;
+	graph::algorithm ga;
+
+	gl.load(graph::files::Kostenminimal1, gg);
+
+	const auto write = [&](const double lower_bound)
+	{
+		std::ofstream file(file_name);
+
+		file << "p min " << gg.get_vertex_count() << " " << gg.get_edge_count() << "\n";
+		for(const graph::vertex* v : gg.get_vertices())
+		{
+			if(v->get_balance() != 0.0)
+				file << "n " << v->get_id() + 1 << " " << v->get_balance() << "\n";
+		}
+		write_dimacs_arcs(file, gg,
+			[lower_bound](std::ofstream& fs, const graph::edge* e)
+			{
+				fs << " " << lower_bound << " " << e->get_capacity() << " " << e->get_cost();
+			});
+	};
+
+	write(0.0);
+	ASSERT_TRUE(gl.load_dimacs_minimum_cost_flow(file_name, gg_dimacs));
+	ASSERT_EQ(gg_dimacs.get_vertex_count(), gg.get_vertex_count());
+	ASSERT_EQ(gg_dimacs.get_edge_count(), gg.get_edge_count());
+
+	bool minimum_cost_flow_found = false;
+	double minimum_cost_flow = 0.0;
+
+	ga.successive_shortest_path(
+		&gg_dimacs, &minimum_cost_flow_found, &minimum_cost_flow);
+
+	EXPECT_TRUE(minimum_cost_flow_found);
+	EXPECT_EQ(minimum_cost_flow, 3.0);
+
+	// Lower bounds are not supported.
+	graph::graph gg_lower_bound;
+
+	write(1.0);
+	EXPECT_FALSE(gl.load_dimacs_minimum_cost_flow(file_name, gg_lower_bound));
+
+	std::remove(file_name.c_str());
+}
+
+TEST(graph_loader, metis)
+{
+	const std::string file_name = "graph_loader_test.graph";
+
+	graph::graph gg;
+	graph::loader gl;
+
+	{
+		std::ofstream file(file_name);
+
+		// 5 vertices, 2 edges with weights, vertices 3 and 4 are isolated
+		file << "% comment\r\n5 2 001\r\n2 1.5 3 2\r\n1 1.5\r\n% comment\r\n1 2\r\n\r\n\r\n";
+	}
+
+	ASSERT_TRUE(gl.load_metis(file_name, gg));
+	EXPECT_EQ(gg.get_vertex_count(), 5);
+
+	// Undirected, both directions are stored.
+	EXPECT_EQ(gg.get_edge_count(), 4);
+	EXPECT_EQ(gg.get_edge(gg.get_vertex(0), gg.get_vertex(1))->get_weight(), 1.5);
+	EXPECT_EQ(gg.get_edge(gg.get_vertex(2), gg.get_vertex(0))->get_weight(), 2.0);
+	EXPECT_EQ(gg.get_vertex(4)->get_out_degree(), 0);
+
+	{
+		std::ofstream file(file_name);
+
+		// The header announces more edges than listed.
+		file << "3 2\n2\n1\n\n";
+	}
+
+	graph::graph gg_invalid;
+
+	EXPECT_FALSE(gl.load_metis(file_name, gg_invalid));
+
+	std::remove(file_name.c_str());
+}
+
+TEST(graph_text_parser, read)
+{
+	const std::string text = "3\r\n0\t1\t-2.5\r\n2 1 1e3\nx";
+	graph::text_parser parser(text.data(), text.data() + text.size());
+	std::uint32_t id = 0;
+	double value = 0.0;
+
+	EXPECT_TRUE(parser.read(&id));
+	EXPECT_EQ(id, 3);
+	EXPECT_TRUE(parser.read(&id));
+	EXPECT_TRUE(parser.read(&id));
+	EXPECT_EQ(id, 1);
+	EXPECT_TRUE(parser.read(&value));
+	EXPECT_EQ(value, -2.5);
+	EXPECT_TRUE(parser.read(&id));
+	EXPECT_TRUE(parser.read(&id));
+	EXPECT_TRUE(parser.read(&value));
+	EXPECT_EQ(value, 1000.0);
+
+	// Malformed input is not consumed.
+	EXPECT_FALSE(parser.read(&id));
+	EXPECT_FALSE(parser.at_end());
+
+	graph::mapped_file missing("../graph/does_not_exist.txt");
+	EXPECT_FALSE(missing.is_open());
+	EXPECT_EQ(missing.get_size(), 0);
+
+	graph::mapped_file existing("../graph/Graph2.txt");
+	EXPECT_TRUE(existing.is_open());
+	EXPECT_GT(existing.get_size(), 0);
+}
+
+TEST(graph_thread_pool, parallel_for)
+{
+	graph::thread_pool pool(4);
+	std::vector<std::uint32_t> values(1000, 0);
+
+	EXPECT_EQ(pool.get_thread_count(), 4);
+
+	// A single index runs on the calling thread, the workers start with
+	// the first larger loop.
+	pool.parallel_for(1, [&](std::size_t i) { values[i] = 0; });
+	EXPECT_EQ(pool.get_started_thread_count(), 1);
+
+	for(std::uint32_t round = 1; round <= 3; ++round)
+	{
+		pool.parallel_for(values.size(), [&](std::size_t i) { values[i] += i; });
+
+		for(std::size_t i = 0; i < values.size(); ++i)
+			EXPECT_EQ(values[i], round * i);
+
+		EXPECT_EQ(pool.get_started_thread_count(), 4);
+	}
+
+	// Two callers of a shared pool run their loops one after the other.
+	std::vector<std::uint32_t> lhs(1000, 0), rhs(1000, 0);
+	std::thread other(
+		[&]
+		{
+			for(int round = 0; round < 100; ++round)
+				pool.parallel_for(rhs.size(), [&](std::size_t i) { ++rhs[i]; });
+		});
+
+	for(int round = 0; round < 100; ++round)
+		pool.parallel_for(lhs.size(), [&](std::size_t i) { ++lhs[i]; });
+	other.join();
+
+	EXPECT_EQ(lhs, std::vector<std::uint32_t>(1000, 100));
+	EXPECT_EQ(rhs, std::vector<std::uint32_t>(1000, 100));
+}
+
+TEST(graph_loader, parallel_chunks)
+{
+	graph::graph gg_serial, gg_parallel;
+	graph::loader gl_serial, gl_parallel;
+
+	gl_serial.set_thread_count(1);
+	gl_parallel.set_thread_count(4);
+
+	// Large enough to be split into several chunks
+	gl_serial.load(graph::files::G_10_200, gg_serial);
+	gl_parallel.load(graph::files::G_10_200, gg_parallel);
+
+	ASSERT_EQ(gg_serial.get_vertex_count(), gg_parallel.get_vertex_count());
+	ASSERT_EQ(gg_serial.get_edge_count(), gg_parallel.get_edge_count());
+
+	auto serial = gg_serial.get_edges();
+	auto parallel = gg_parallel.get_edges();
+
+	for(; serial.first != serial.second; ++serial.first, ++parallel.first)
+	{
+		const graph::edge* lhs = *serial.first;
+		const graph::edge* rhs = *parallel.first;
+
+		ASSERT_EQ(lhs->get_source()->get_id(), rhs->get_source()->get_id());
+		ASSERT_EQ(lhs->get_target()->get_id(), rhs->get_target()->get_id());
+		ASSERT_EQ(lhs->get_weight(), rhs->get_weight());
+	}
+}
+
+TEST(graph_graphml_reader, data_keys)
+{
+	const std::string text =
+		"<?xml version=\"1.0\"?>\n"
+		"<!-- comment with <node> -->\n"
+		"<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n"
+		"<key id=\"w\" for=\"edge\" attr.name=\"weight\" attr.type=\"double\"/>\n"
+		"<key id=\"b\" for=\"node\" attr.name=\"balance\" attr.type=\"double\"/>\n"
+		"<key id=\"c\" for=\"node\" attr.name=\"color\" attr.type=\"string\"/>\n"
+		"<graph id=\"G\" edgedefault=\"directed\">\n"
+		"<node id='a'><data key='b'> 2.5 </data><data key='c'>red</data></node>\n"
+		"<edge source=\"a\" target=\"c\"><data key=\"w\"><![CDATA[-1.5]]></data></edge>\n"
+		"<node id=\"b\"><data key=\"b\">-2.5</data>\n"
+		"<graph id=\"G:b\"><node id=\"c\"/></graph></node>\n"
+		"</graph>\n"
+		"</graphml>\n";
+	graph::graphml_reader reader;
+	graph::graph gg;
+
+	ASSERT_TRUE(reader.read(text.data(), text.data() + text.size()));
+	reader.build(gg, true);
+
+	// Without labels the nodes are numbered in order of appearance.
+	ASSERT_EQ(gg.get_vertex_count(), 3);
+	ASSERT_EQ(gg.get_edge_count(), 1);
+	EXPECT_EQ(gg.get_vertex(0)->get_balance(), 2.5);
+	EXPECT_EQ(gg.get_vertex(1)->get_balance(), 0.0);
+	EXPECT_EQ(gg.get_vertex(2)->get_balance(), -2.5);
+
+	const graph::edge* e = gg.get_edge(gg.get_vertex(0), gg.get_vertex(1));
+	ASSERT_NE(e, nullptr);
+	EXPECT_EQ(e->get_weight(), -1.5);
+
+	const std::string malformed = "<graphml><graph><node id=\"a\"></graph>";
+	graph::graphml_reader malformed_reader;
+
+	EXPECT_FALSE(malformed_reader.read(
+		malformed.data(), malformed.data() + malformed.size()));
+}
+
+TEST(graph_loader, graphml_yed_files)
+{
+	graph::loader gl;
+	graph::graph missing;
+
+	EXPECT_FALSE(gl.load_graphml("../graph/does_not_exist.graphml", missing));
+
+	// Edge labels hold the weight
+	graph::graph wege_txt, wege_graphml;
+
+	gl.load(graph::files::Wege1, wege_txt, true);
+	ASSERT_TRUE(gl.load_graphml("../graph/wege1.graphml", wege_graphml, true));
+
+	ASSERT_EQ(wege_txt.get_vertex_count(), wege_graphml.get_vertex_count());
+	ASSERT_EQ(wege_txt.get_edge_count(), wege_graphml.get_edge_count());
+
+	for(auto edges = wege_txt.get_edges(); edges.first != edges.second; ++edges.first)
+	{
+		const graph::edge* e = wege_graphml.get_edge(*edges.first);
+
+		ASSERT_NE(e, nullptr);
+		EXPECT_EQ(e->get_weight(), (*edges.first)->get_weight());
+	}
+
+	// Node labels "id/balance", edge labels "capacity/cost"
+	graph::graph flow_txt, flow_graphml;
+
+	gl.load(graph::files::Kostenminimal3, flow_txt);
+	ASSERT_TRUE(gl.load_graphml("../graph/Kostenminimal3.graphml", flow_graphml, true));
+
+	ASSERT_EQ(flow_txt.get_vertex_count(), flow_graphml.get_vertex_count());
+	ASSERT_EQ(flow_txt.get_edge_count(), flow_graphml.get_edge_count());
+
+	for(auto vertices = flow_txt.get_vertices(); vertices.first != vertices.second; ++vertices.first)
+	{
+		const graph::vertex* v = *vertices.first;
+
+		EXPECT_EQ(v->get_balance(), flow_graphml.get_vertex(v->get_id())->get_balance());
+	}
+
+	double cost_txt = 0.0, cost_graphml = 0.0;
+	double capacity_txt = 0.0, capacity_graphml = 0.0;
+
+	for(auto edges = flow_txt.get_edges(); edges.first != edges.second; ++edges.first)
+	{
+		cost_txt += (*edges.first)->get_cost();
+		capacity_txt += (*edges.first)->get_capacity();
+
+		const graph::edge* e = flow_graphml.get_edge(*edges.first);
+		ASSERT_NE(e, nullptr);
+	}
+	for(auto edges = flow_graphml.get_edges(); edges.first != edges.second; ++edges.first)
+	{
+		cost_graphml += (*edges.first)->get_cost();
+		capacity_graphml += (*edges.first)->get_capacity();
+	}
+
+	EXPECT_EQ(cost_txt, cost_graphml);
+	EXPECT_EQ(capacity_txt, capacity_graphml);
+}